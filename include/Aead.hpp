@@ -0,0 +1,73 @@
+#pragma once
+#include <cstddef>
+#include <Types.hpp>
+
+/**
+ * @brief 按加密套件加密数据并生成 tag
+ *
+ * @note x86 平台在运行时检测 AES-NI/PCLMUL, 支持时使用硬件指令, 否则使用 uAES
+ *
+ * @param suite 加密套件
+ * @param key 密钥, AES-128 使用前 16 字节
+ * @param nonce 随机数
+ * @param data 数据, 原地加密
+ * @param size 数据长度
+ * @param tag [out]tag, 长度为 suite.tag_size()
+ */
+void aead_encrypt(const CipherSuite& suite, const KeyType& key, const NonceType& nonce, uint8_t* data, size_t size,
+                  uint8_t* tag);
+
+/**
+ * @brief 按加密套件解密数据并验证 tag
+ *
+ * @note tag 验证失败时 data 的内容无意义
+ *
+ * @param suite 加密套件
+ * @param key 密钥, AES-128 使用前 16 字节
+ * @param nonce 随机数
+ * @param data 数据, 原地解密
+ * @param size 数据长度
+ * @param tag tag, 长度为 suite.tag_size()
+ * @return true 验证成功
+ * @return false 验证失败
+ */
+bool aead_decrypt(const CipherSuite& suite, const KeyType& key, const NonceType& nonce, uint8_t* data, size_t size,
+                  const uint8_t* tag);
+
+/**
+ * @brief 使用 uAES 加密, 固件及不支持硬件加速的平台使用
+ *
+ */
+void aead_encrypt_sw(const CipherSuite& suite, const KeyType& key, const NonceType& nonce, uint8_t* data, size_t size,
+                     uint8_t* tag);
+
+/**
+ * @brief 使用 uAES 解密, 固件及不支持硬件加速的平台使用
+ *
+ */
+bool aead_decrypt_sw(const CipherSuite& suite, const KeyType& key, const NonceType& nonce, uint8_t* data, size_t size,
+                     const uint8_t* tag);
+
+/**
+ * @brief 使用 AES-NI/PCLMUL 指令加密
+ *
+ * @note 仅在 aead_hw_supported() 返回 true 时可用
+ */
+void aead_encrypt_hw(const CipherSuite& suite, const KeyType& key, const NonceType& nonce, uint8_t* data, size_t size,
+                     uint8_t* tag);
+
+/**
+ * @brief 使用 AES-NI/PCLMUL 指令解密
+ *
+ * @note 仅在 aead_hw_supported() 返回 true 时可用
+ */
+bool aead_decrypt_hw(const CipherSuite& suite, const KeyType& key, const NonceType& nonce, uint8_t* data, size_t size,
+                     const uint8_t* tag);
+
+/**
+ * @brief 当前平台是否支持硬件加速 AES
+ *
+ * @return true 支持
+ * @return false 不支持
+ */
+bool aead_hw_supported();
@@ -0,0 +1,113 @@
+#pragma once
+#include "Lock.hpp"
+#include <Extra.hpp>
+#include <FixedQueue.hpp>
+
+/**
+ * @brief 异步帧队列接口
+ *
+ * @details
+ * Client 等待响应时收到的异步帧(如 LOG, LOG_BATCH)被放入队列,
+ * 由独立的消费者调用 HostClient::dispatch 处理, 缓慢的日志输出不会拖慢属性读写
+ */
+struct AsyncQueueBase
+{
+    /**
+     * @brief 放入一帧
+     *
+     * @param cmd 命令
+     * @param data 附加参数
+     * @param size 附加参数长度
+     * @return true 成功
+     * @return false 队列满, 帧被丢弃
+     */
+    virtual bool push(Command cmd, const uint8_t* data, Size size) = 0;
+    /**
+     * @brief 取出一帧
+     *
+     * @param cmd [out]命令
+     * @param extra [out]附加参数, 超出缓冲区长度的部分被丢弃
+     * @return true 成功
+     * @return false 队列空
+     */
+    virtual bool pop(Command& cmd, Extra& extra)                   = 0;
+
+    /**
+     * @brief 获取因队列满而丢弃的帧数
+     *
+     * @return uint32_t 丢弃的帧数
+     */
+    uint32_t dropped() const
+    {
+        return _dropped;
+    }
+
+  protected:
+    // 丢弃的帧数
+    volatile uint32_t _dropped = 0;
+};
+
+/**
+ * @brief 异步帧队列
+ *
+ * @note 每帧额外占用 3 字节: 命令(uint8_t) + 长度(Size)
+ *
+ * @tparam _size 队列长度
+ */
+template <size_t _size>
+struct AsyncQueue : public AsyncQueueBase
+{
+    /**
+     * @param lock 接收方与消费者之间的互斥锁
+     */
+    AsyncQueue(Lock& lock = no_lock)
+        : _lock(lock)
+    {
+    }
+
+    virtual bool push(Command cmd, const uint8_t* data, Size size) override
+    {
+        LockGuard guard(_lock);
+        if (_queue.capacity() - _queue.size() < sizeof(cmd) + sizeof(size) + size)
+        {
+            _dropped = _dropped + 1;
+            return false;
+        }
+
+        _queue.push((uint8_t)cmd);
+        _queue.push(size & 0xFF);
+        _queue.push(size >> 8);
+        for (Size i = 0; i < size; i++)
+            _queue.push(data[i]);
+        return true;
+    }
+
+    virtual bool pop(Command& cmd, Extra& extra) override
+    {
+        LockGuard guard(_lock);
+        if (_queue.empty()) return false;
+
+        uint8_t byte;
+        Size    size;
+        _queue.pop(&byte);
+        cmd = (Command)byte;
+        _queue.pop(&byte);
+        size = byte;
+        _queue.pop(&byte);
+        size |= byte << 8;
+
+        extra.reset();
+        extra.size() = std::min(size, extra.capacity());
+        for (Size i = 0; i < size; i++)
+        {
+            _queue.pop(&byte);
+            if (i < extra.size()) extra.data()[i] = byte;
+        }
+        return true;
+    }
+
+  protected:
+    // 接收方与消费者之间的互斥锁
+    Lock&             _lock;
+    FixedQueue<_size> _queue;
+};
@@ -0,0 +1,80 @@
+#pragma once
+#include "Memory.hpp"
+#include <checksum.h>
+
+/**
+ * @brief 支持事务写入的内存区属性
+ *
+ * @details
+ * BEGIN 之后的分块写入只修改影子缓冲区, 属性值保持不变;
+ * COMMIT 时校验影子缓冲区整体的 CRC32, 一致才复制到属性值, 否则放弃本次事务;
+ * 不在事务中的写入与 Memory 相同, 直接修改属性值
+ *
+ * @note 需要额外占用 sizeof(T) 字节的内存
+ *
+ * @tparam T 标准布局类型
+ * @tparam access 访问级别
+ */
+template <PropertyVal T, Access _access = Access::READ>
+struct AtomicMemory : public Memory<T, _access>
+{
+    using parent = Memory<T, _access>;
+
+    AtomicMemory(T& value)
+        : parent(value)
+    {
+    }
+
+    virtual ErrorCode set(Extra& extra, bool privileged) override
+    {
+        if (!_active) return parent::set(extra, privileged);
+
+        MemoryAccess access;
+        // 检查访问参数是否正确
+        if (!extra.get(access) || access.size != extra.remain()) return ErrorCode::E_INVALID_ARG;
+        // 检查是否超出内存区范围
+        if (sizeof(_shadow) < access.offset + access.size) return ErrorCode::E_OUT_OF_INDEX;
+
+        memcpy((uint8_t*)&_shadow + access.offset, extra.curr(), access.size);
+        extra.reset();
+        return ErrorCode::S_OK;
+    }
+
+    virtual ErrorCode begin(Extra& extra, bool) override
+    {
+        // 未写入的部分保持原值
+        memcpy(&_shadow, &this->_value, sizeof(_shadow));
+        _active = true;
+        extra.reset();
+        return ErrorCode::S_OK;
+    }
+
+    virtual ErrorCode commit(Extra& extra, bool) override
+    {
+        if (!_active) return ErrorCode::E_ILLEGAL_STATE;
+
+        // 无论校验结果如何, 事务都已结束
+        _active = false;
+        uint32_t crc;
+        if (!extra.get(crc)) return ErrorCode::E_INVALID_ARG;
+        extra.reset();
+
+        // 数据不完整, 放弃本次事务
+        if (crc != crc_32((const uint8_t*)&_shadow, sizeof(_shadow))) return ErrorCode::E_FAIL;
+        memcpy(&this->_value, &_shadow, sizeof(_shadow));
+        return ErrorCode::S_OK;
+    }
+
+    virtual ErrorCode abort(Extra& extra, bool) override
+    {
+        _active = false;
+        extra.reset();
+        return ErrorCode::S_OK;
+    }
+
+  protected:
+    // 是否处于事务中
+    bool _active = false;
+    // 影子缓冲区
+    T    _shadow;
+};
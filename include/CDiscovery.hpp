@@ -0,0 +1,115 @@
+#pragma once
+#include <HostClient.hpp>
+
+/**
+ * @brief 地址发现(客户端)
+ *
+ * @details
+ * discover 先广播不带参数的 DISCOVER 使所有设备恢复为未分配状态, 然后从空前缀开始查询:
+ * 匹配前缀的未分配设备在各自的时隙应答唯一Id, 收到的唯一Id逐个以 ASSIGN 分配地址, 分配后的设备不再应答;
+ * 查询期间出现校验失败或帧同步丢弃的字节时说明有设备冲突, 将前缀延长 1 位分为两半继续查询.
+ * 总的请求数与设备数成正比, 与地址空间的大小无关
+ *
+ * @note 查询期间 Client 的地址临时切换为广播地址, 以接收所有设备的应答
+ * @note 接收超时应当大于 slots * width, 否则晚到的应答会被当作冲突
+ */
+struct CDiscoveryBase
+{
+    // 每次查询的时隙数
+    uint8_t  slots = 16;
+    // 时隙宽度, 微秒, 应当大于一帧应答的传输时间
+    uint16_t width = 0;
+
+    ErrorCode discover(HostClient& client, Address first);
+
+    /**
+     * @brief 获取发现的设备数
+     *
+     * @return size_t 设备数
+     */
+    size_t size() const
+    {
+        return _count;
+    }
+
+    /**
+     * @brief 获取第 i 个设备的唯一Id
+     *
+     * @param i 序号
+     * @return const UniqueId& 唯一Id
+     */
+    const UniqueId& uid(size_t i) const
+    {
+        return _uids[i];
+    }
+
+    /**
+     * @brief 获取第 i 个设备分配的地址
+     *
+     * @param i 序号
+     * @return Address 地址
+     */
+    Address address(size_t i) const
+    {
+        return _addresses[i];
+    }
+
+    /**
+     * @brief 获取最近一次 discover 发送的查询数
+     *
+     * @return uint32_t 查询数
+     */
+    uint32_t queries() const
+    {
+        return _queries;
+    }
+
+  protected:
+    CDiscoveryBase(UniqueId* uids, Address* addresses, size_t devices)
+        : _uids(uids)
+        , _addresses(addresses)
+        , _devices_max(devices)
+    {
+    }
+
+    ErrorCode search(HostClient& client, DiscoverRequest req);
+    ErrorCode query(HostClient& client, DiscoverRequest& req, bool& collided);
+    ErrorCode assign(HostClient& client, const UniqueId& uid, Address target);
+
+  protected:
+    // 发现的设备的唯一Id
+    UniqueId* const _uids;
+    // 分配的地址
+    Address* const  _addresses;
+    // 最多保存的设备数
+    const size_t    _devices_max;
+
+    // 发现的设备数
+    size_t          _count      = 0;
+    // 下一个分配的地址
+    Address         _next       = 0;
+    // 随机种子, 每次查询递增
+    uint16_t        _seed       = 0;
+    // 查询数
+    uint32_t        _queries    = 0;
+    // 前缀已完整仍然冲突的次数, 唯一Id可能重复
+    uint32_t        _unresolved = 0;
+};
+
+/**
+ * @brief 地址发现(客户端)
+ *
+ * @tparam _devices 最多保存的设备数
+ */
+template <size_t _devices = 64>
+struct CDiscovery : public CDiscoveryBase
+{
+    CDiscovery()
+        : CDiscoveryBase(_uid_buf, _address_buf, _devices)
+    {
+    }
+
+  protected:
+    UniqueId _uid_buf[_devices];
+    Address  _address_buf[_devices];
+};
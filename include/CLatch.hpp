@@ -0,0 +1,124 @@
+#pragma once
+#include <HostClient.hpp>
+
+/**
+ * @brief 锁存器句柄(客户端)
+ *
+ * @details
+ * trigger 向广播/组播地址发送 LATCH, 各 Server 在同一时刻锁存; collect 之后逐个设备读取锁存值,
+ * 序号与本次触发不一致的设备(漏收了 LATCH)视为失败
+ *
+ * @code
+ * struct Sample { float speed; uint32_t status; };
+ * CLatch<Sample> latch("latch");
+ * latch.trigger(client, ADDRESS_BROADCAST, 1);
+ * latch.collect(client, addresses, 32, 1, samples);
+ * @endcode
+ *
+ * @tparam T 锁存值类型, 按 Server 锁存通道的顺序紧密排列
+ */
+template <PropertyVal T>
+struct CLatch
+{
+    // 锁存器的属性名称
+    const frozen::string name;
+
+    CLatch(const frozen::string name)
+        : name(name)
+    {
+    }
+
+    /**
+     * @brief 触发锁存, 不等待应答
+     *
+     * @note 发往单播地址时 Server 仍会应答, 应使用 latch
+     *
+     * @param client Client
+     * @param target 广播或组播地址
+     * @param seq 序号
+     * @return ErrorCode 错误码, 只反映请求是否发出
+     */
+    ErrorCode trigger(HostClient& client, Address target, uint16_t seq) const
+    {
+        Extra& extra = client.extra;
+        extra.reset();
+        extra.add(seq);
+        client.send_to(target, Command::LATCH, extra, false);
+        return ErrorCode::S_OK;
+    }
+
+    /**
+     * @brief 触发当前地址的 Server 锁存, 等待应答
+     *
+     * @param client Client
+     * @param seq 序号
+     * @return ErrorCode 错误码
+     */
+    ErrorCode latch(HostClient& client, uint16_t seq) const
+    {
+        ErrorCode err;
+        Extra&    extra = client.extra;
+        extra.reset();
+        extra.add(seq);
+        client.send(Command::LATCH, extra, false);
+        if (!client.recv_response(Command::LATCH, err, extra)) return ErrorCode::E_TIMEOUT;
+        return err;
+    }
+
+    /**
+     * @brief 读取当前地址的 Server 的锁存值
+     *
+     * @param client Client
+     * @param seq [out]锁存的序号
+     * @param value [out]锁存值
+     * @return ErrorCode 错误码
+     */
+    ErrorCode get(HostClient& client, uint16_t& seq, T& value) const
+    {
+        PropertyId id;
+        ErrorCode  err = client.holder.get_id_by_name(name, id);
+        if (err != ErrorCode::S_OK) return err;
+
+        Extra& extra = client.extra;
+        extra.reset();
+        extra.add(id);
+        client.send(Command::GET_PROPERTY, extra, false);
+        if (!client.recv_response(Command::GET_PROPERTY, err, extra)) return ErrorCode::E_TIMEOUT;
+        if (err != ErrorCode::S_OK) return err;
+        // 锁存值长度必须与类型一致
+        if (extra.remain() != sizeof(seq) + sizeof(T)) return ErrorCode::E_FAIL;
+        extra.get(seq);
+        extra.get(value);
+        client.record(name, &value, sizeof(T));
+        return ErrorCode::S_OK;
+    }
+
+    /**
+     * @brief 依次读取各设备的锁存值
+     *
+     * @param client Client, 读取期间临时切换其目标地址
+     * @param addresses 设备地址
+     * @param size 设备个数
+     * @param seq 本次触发的序号
+     * @param values [out]各设备的锁存值
+     * @param results [out]各设备的结果, S_OK 为成功, E_FAIL 为序号不一致, 其他为读取错误; 可为空
+     * @return size_t 成功读取本次锁存值的设备个数
+     */
+    size_t collect(HostClient& client, const Address* addresses, size_t size, uint16_t seq, T* values,
+                   ErrorCode* results = nullptr) const
+    {
+        Address self  = client.address;
+        size_t  match = 0;
+        for (size_t i = 0; i < size; i++)
+        {
+            uint16_t latched;
+            client.address = addresses[i];
+            ErrorCode err  = get(client, latched, values[i]);
+            if (err == ErrorCode::S_OK && latched != seq) err = ErrorCode::E_FAIL;
+            if (err == ErrorCode::S_OK) match++;
+            if (results) results[i] = err;
+        }
+        client.address = self;
+        return match;
+    }
+};
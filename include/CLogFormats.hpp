@@ -0,0 +1,62 @@
+#pragma once
+#include <HostClient.hpp>
+
+/**
+ * @brief 日志格式表(客户端)
+ *
+ * @details
+ * 客户端连接服务端后, 通过 refresh 从 LogFormats 属性获取格式表并缓存;
+ * 收到二进制日志时, 根据格式Id查表并按转换说明解包参数, 展开为文本
+ */
+struct CLogFormatsBase
+{
+    // 绑定的属性名称
+    const frozen::string name;
+
+    ErrorCode refresh(HostClient& client);
+    size_t    expand(const uint8_t* log, size_t size, char* out, size_t capacity) const;
+    Size      size() const;
+
+  protected:
+    CLogFormatsBase(const frozen::string name, char* pool, size_t chars, Size* offsets, size_t count)
+        : name(name)
+        , _pool(pool)
+        , _pool_size(chars)
+        , _offsets(offsets)
+        , _capacity(count)
+    {
+    }
+
+  protected:
+    // 格式字符串存储区
+    char* const  _pool;
+    // 存储区长度
+    const size_t _pool_size;
+    // 格式字符串在存储区中的偏移, 第 i 个格式为 [_offsets[i], _offsets[i + 1])
+    Size* const  _offsets;
+    // 最多缓存的格式个数
+    const size_t _capacity;
+    // 已获取的格式个数
+    Size         _loaded = 0;
+};
+
+/**
+ * @brief 日志格式表(客户端)
+ *
+ * @tparam _count 最多缓存的格式个数
+ * @tparam _chars 格式字符串的总长度上限
+ */
+template <size_t _count, size_t _chars>
+struct CLogFormats : public CLogFormatsBase
+{
+    static_assert(_chars <= UINT16_MAX, "CLogFormats is too large");
+
+    CLogFormats(const frozen::string name)
+        : CLogFormatsBase(name, _buf, _chars, _index, _count)
+    {
+    }
+
+  protected:
+    char _buf[_chars];
+    Size _index[_count + 1];
+};
@@ -2,6 +2,8 @@
 #include "Types.hpp"
 #include <cstddef>
 #include <cstdint>
+#include <checksum.h>
+#include <Crc.hpp>
 #include <HostClient.hpp>
 #include <Memory.hpp>
 
@@ -9,6 +11,7 @@
  * @brief 内存区属性(客户端)
  *
  * @note 内存区属性的读写分块进行, 需要额外的机制来保障数据的完整性
+ * @note Server 使用 AtomicMemory 时, 可通过 set_atomic 以事务的方式写入
  *
  * @tparam T 属性类型
  * @tparam access 访问级别
@@ -62,16 +65,139 @@ struct CMemory
         extra.add(access);
         // 发送请求
         client.send(Command::GET_PROPERTY, extra, encrypt);
-        // 接收响应
-        if (!client.recv_response(Command::GET_PROPERTY, err, extra)) return ErrorCode::E_TIMEOUT;
+        // 接收响应 - 未加密的数据直接写入 data
+        DirectBuffer direct = {Command::GET_PROPERTY, data, access.size, false};
+        if (!client.recv_response(Command::GET_PROPERTY, err, extra, encrypt ? nullptr : &direct))
+            return ErrorCode::E_TIMEOUT;
         if (err != ErrorCode::S_OK) return err;
         // 接收数据
-        if (!extra.get(data, access.size)) return ErrorCode::E_FAIL;
+        if (!direct.used && !extra.get(data, access.size)) return ErrorCode::E_FAIL;
         // 自增偏移
         access.offset += access.size;
         return ErrorCode::S_OK;
     }
 
+    ErrorCode get_crc(HostClient& client, MemoryAccess access, CrcType type, uint64_t& value) const
+    {
+        ErrorCode err;
+        Extra&    extra   = client.extra;
+        // 是否需要加密
+        bool      encrypt = _access == Access::READ_WRITE_PROTECT || _access == Access::READ_PROTECT;
+
+        extra.reset();
+        // 添加id
+        PropertyId id;
+        err = client.holder.get_id_by_name(name, id);
+        if (err != ErrorCode::S_OK) return err;
+        extra.add(id);
+        // 添加访问参数
+        extra.add(access);
+        // 添加校验和类型
+        extra.add(type);
+        // 发送请求
+        client.send(Command::GET_CRC, extra, encrypt);
+        // 接收响应
+        if (!client.recv_response(Command::GET_CRC, err, extra)) return ErrorCode::E_TIMEOUT;
+        if (err != ErrorCode::S_OK) return err;
+        // 读取校验和
+        if (!Crc::get(extra, type, value)) return ErrorCode::E_FAIL;
+        return ErrorCode::S_OK;
+    }
+
+    /**
+     * @brief 校验 Server 的内存区与本地数据是否一致
+     *
+     * @note Server 计算校验和, 无需回读数据
+     *
+     * @param client 客户端实例
+     * @param offset 内存区偏移
+     * @param buffer 本地数据
+     * @param size 数据长度
+     * @param type 校验和类型
+     * @return ErrorCode 一致时返回 S_OK, 不一致时返回 E_FAIL
+     */
+    ErrorCode verify(HostClient& client, Size offset, const void* buffer, Size size,
+                     CrcType type = CrcType::CRC32) const
+    {
+        MemoryAccess access;
+        access.offset = offset;
+        access.size   = size;
+
+        uint64_t  remote;
+        ErrorCode err;
+        if ((err = get_crc(client, access, type, remote)) != ErrorCode::S_OK) return err;
+
+        Crc local(type);
+        local.update(buffer, size);
+        return local.value() == remote ? ErrorCode::S_OK : ErrorCode::E_FAIL;
+    }
+
+    ErrorCode control(HostClient& client, Command cmd, const void* arg = nullptr, size_t size = 0) const
+    {
+        if (_access == Access::READ || _access == Access::READ_PROTECT) return ErrorCode::E_READ_ONLY;
+
+        ErrorCode err;
+        Extra&    extra   = client.extra;
+        // 是否需要加密
+        bool      encrypt = _access == Access::READ_WRITE_PROTECT || _access == Access::WRITE_PROTECT;
+
+        extra.reset();
+        // 添加id
+        PropertyId id;
+        err = client.holder.get_id_by_name(name, id);
+        if (err != ErrorCode::S_OK) return err;
+        extra.add(id);
+        // 添加参数
+        if (size > 0 && !extra.add(arg, size)) return ErrorCode::E_OUT_OF_BUFFER;
+        // 发送请求
+        client.send(cmd, extra, encrypt);
+        // 接收响应
+        if (!client.recv_response(cmd, err, extra)) return ErrorCode::E_TIMEOUT;
+        if (err != ErrorCode::S_OK) return err;
+        return ErrorCode::S_OK;
+    }
+
+    ErrorCode commit(HostClient& client) const
+    {
+        return control(client, Command::COMMIT);
+    }
+
+    ErrorCode commit(HostClient& client, uint32_t crc) const
+    {
+        return control(client, Command::COMMIT, &crc, sizeof(crc));
+    }
+
+    ErrorCode begin(HostClient& client) const
+    {
+        return control(client, Command::BEGIN);
+    }
+
+    ErrorCode abort(HostClient& client) const
+    {
+        return control(client, Command::ABORT);
+    }
+
+    /**
+     * @brief 以事务的方式写入整个内存区
+     *
+     * @note 写入过程中 Server 的属性值保持不变, 提交时校验整体的 CRC32
+     *
+     * @param client 客户端实例
+     * @param value 属性值
+     * @return ErrorCode 错误码
+     */
+    ErrorCode set_atomic(HostClient& client, const T& value) const
+    {
+        ErrorCode err;
+        if ((err = begin(client)) != ErrorCode::S_OK) return err;
+        if ((err = set(client, 0, &value, sizeof(value))) != ErrorCode::S_OK)
+        {
+            abort(client);
+            return err;
+        }
+        return commit(client, crc_32((const uint8_t*)&value, sizeof(value)));
+    }
+
     ErrorCode set(HostClient& client, Size offset, const void* buffer, size_t size) const
     {
         if (_access == Access::READ || _access == Access::READ_PROTECT) return ErrorCode::E_READ_ONLY;
@@ -79,9 +205,9 @@ struct CMemory
         // 是否需要加密
         bool         encrypt = _access == Access::READ_WRITE_PROTECT || _access == Access::WRITE_PROTECT;
         // 每次同步的最大长度
-        Size         space   = MEMORY_ACCESS_SIZE_MAX;
+        Size         space   = client.memory_access_size();
         // buffer的偏移
-        Size         _offset = 0;
+        size_t       _offset = 0;
         // 内存访问参数
         MemoryAccess access;
         access.size   = space;
@@ -113,9 +239,9 @@ struct CMemory
         // 是否需要加密
         bool         encrypt = _access == Access::READ_WRITE_PROTECT || _access == Access::READ_PROTECT;
         // 每次同步的最大长度
-        Size         space   = MEMORY_ACCESS_SIZE_MAX;
+        Size         space   = client.memory_access_size();
         // buffer 的偏移
-        Size         _offset = 0;
+        size_t       _offset = 0;
         // 内存访问参数
         MemoryAccess access;
         access.size   = space;
@@ -21,6 +21,79 @@ struct CProperty
     }
 
     ErrorCode get(HostClient& client, T& value) const
+    {
+        PropertyId id;
+        ErrorCode  err = client.holder.get_id_by_name(name, id);
+        if (err != ErrorCode::S_OK) return err;
+        return get(client, id, value);
+    }
+
+    ErrorCode set(HostClient& client, const T value) const
+    {
+        PropertyId id;
+        ErrorCode  err = client.holder.get_id_by_name(name, id);
+        if (err != ErrorCode::S_OK) return err;
+        return set(client, id, value);
+    }
+
+    /**
+     * @brief 向广播/组播地址写入属性值, Server 静默执行, 不应答
+     *
+     * @note 所有目标设备的属性Id必须与本机的Id表一致; 写入结果由 sweep 验证
+     * @note 各设备的随机数不同且每帧更新, 没有共用的组密钥, 写保护的属性不能广播写入
+     *
+     * @param client Client
+     * @param target 广播或组播地址
+     * @param value 属性值
+     * @return ErrorCode 错误码, 只反映请求是否发出; 写保护的属性返回 E_NO_PERMISSION
+     */
+    ErrorCode broadcast(HostClient& client, Address target, const T value) const
+    {
+        if (access == Access::READ || access == Access::READ_PROTECT) return ErrorCode::E_READ_ONLY;
+        if (access == Access::READ_WRITE_PROTECT || access == Access::WRITE_PROTECT) return ErrorCode::E_NO_PERMISSION;
+
+        PropertyId id;
+        ErrorCode  err = client.holder.get_id_by_name(name, id);
+        if (err != ErrorCode::S_OK) return err;
+
+        Extra& extra = client.extra;
+        extra.reset();
+        extra.add(id);
+        if (!extra.add(value)) return ErrorCode::E_OUT_OF_BUFFER;
+        client.send_to(target, Command::SET_PROPERTY, extra, false);
+        return ErrorCode::S_OK;
+    }
+
+    /**
+     * @brief 依次读回各设备的属性值, 验证广播写入的结果
+     *
+     * @param client Client, 读取期间临时切换其目标地址
+     * @param addresses 设备地址
+     * @param size 设备个数
+     * @param expected 期望的属性值
+     * @param results [out]各设备的结果, S_OK 为一致, E_FAIL 为不一致, 其他为读取错误; 可为空
+     * @return size_t 属性值一致的设备个数
+     */
+    size_t sweep(HostClient& client, const Address* addresses, size_t size, const T& expected,
+                 ErrorCode* results = nullptr) const
+    {
+        Address self  = client.address;
+        size_t  match = 0;
+        for (size_t i = 0; i < size; i++)
+        {
+            T value;
+            client.address = addresses[i];
+            ErrorCode err  = get(client, value);
+            if (err == ErrorCode::S_OK && memcmp(&value, &expected, sizeof(T)) != 0) err = ErrorCode::E_FAIL;
+            if (err == ErrorCode::S_OK) match++;
+            if (results) results[i] = err;
+        }
+        client.address = self;
+        return match;
+    }
+
+  protected:
+    ErrorCode get(HostClient& client, PropertyId id, T& value) const
     {
         ErrorCode err;
         Extra&    extra   = client.extra;
@@ -29,9 +102,6 @@ struct CProperty
 
         extra.reset();
         // 添加id
-        PropertyId id;
-        err = client.holder.get_id_by_name(name, id);
-        if (err != ErrorCode::S_OK) return err;
         extra.add(id);
         // 发送请求
         client.send(Command::GET_PROPERTY, extra, encrypt);
@@ -40,10 +110,12 @@ struct CProperty
         if (err != ErrorCode::S_OK) return err;
         // 读取数据
         if (!extra.get(value)) return ErrorCode::E_FAIL;
+        // 记录读取结果
+        client.record(name, &value, sizeof(T));
         return ErrorCode::S_OK;
     }
 
-    ErrorCode set(HostClient& client, const T value) const
+    ErrorCode set(HostClient& client, PropertyId id, const T value) const
     {
         if (access == Access::READ || access == Access::READ_PROTECT) return ErrorCode::E_READ_ONLY;
 
@@ -54,9 +126,6 @@ struct CProperty
 
         extra.reset();
         // 添加id
-        PropertyId id;
-        err = client.holder.get_id_by_name(name, id);
-        if (err != ErrorCode::S_OK) return err;
         extra.add(id);
         // 添加数据
         if (!extra.add(value)) return ErrorCode::E_OUT_OF_BUFFER;
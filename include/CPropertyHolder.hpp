@@ -71,7 +71,7 @@ struct CPropertyHolder : public CPropertyHolderBase
                 // 使用加密模式再获取一次
                 if (get_name(client, i, true) != ErrorCode::S_OK) continue;
                 // 解密数据
-                if (!client.extra.decrypt(client.secret.nonce, client.secret.key)) continue;
+                if (!client.extra.decrypt(client.secret.nonce, client.secret.key, client.cipher())) continue;
             }
 
             frozen::string name((const char*)client.extra.curr(), (size_t)client.extra.remain());
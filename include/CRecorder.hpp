@@ -0,0 +1,115 @@
+#pragma once
+#include <HostClient.hpp>
+#include <Record.hpp>
+#include <string_view>
+
+/**
+ * @brief 属性值记录器(客户端)
+ *
+ * @details
+ * 设置 HostClient::recorder 后, CProperty::get 读取成功的属性值连同时间戳写入记录器;
+ * 每个属性为一个通道, 采样点先缓存在通道的列中, 列存满或调用 flush 时以一个 DATA 块追加到记录文件;
+ * 记录文件的格式见 Record.hpp, 由 Replay 映射后随机访问
+ *
+ * @note 只用于 POSIX 平台的上位机, 实现在 src/posix 中, 由 HostServicePosix 库单独编译
+ */
+struct CRecorderBase
+{
+    virtual ~CRecorderBase();
+
+    ErrorCode         open(const char* path);
+    ErrorCode         close();
+    ErrorCode         flush();
+    // HostClient 经虚函数调用, 核心库不依赖记录器的实现
+    virtual ErrorCode record(const frozen::string name, const void* value, Size size);
+    ErrorCode         record(const frozen::string name, uint64_t time, const void* value, Size size);
+
+    /**
+     * @brief 是否已打开记录文件
+     *
+     * @return true 已打开
+     */
+    bool is_open() const
+    {
+        return _fd >= 0;
+    }
+
+    /**
+     * @brief 获取通道数
+     *
+     * @return size_t 通道数
+     */
+    size_t channels() const
+    {
+        return _count;
+    }
+
+  protected:
+    CRecorderBase(std::string_view* names, uint8_t* widths, size_t* fills, uint64_t* times, uint8_t* values,
+                  size_t channels, size_t depth, size_t width)
+        : _names(names)
+        , _widths(widths)
+        , _fills(fills)
+        , _times(times)
+        , _values(values)
+        , _channels_max(channels)
+        , _depth_max(depth)
+        , _width_max(width)
+    {
+    }
+
+    virtual uint64_t now() const;
+    ErrorCode        flush(size_t channel);
+    ErrorCode        append(RecordKind kind, size_t channel, size_t count, const void* head, size_t head_size,
+                            const void* tail, size_t tail_size);
+
+  protected:
+    // 各通道的属性名称
+    std::string_view* const _names;
+    // 各通道采样值的长度
+    uint8_t* const          _widths;
+    // 各通道已缓存的采样点数
+    size_t* const           _fills;
+    // 时间戳列, 第 i 个通道为 [_times + i * _depth_max, +_depth_max)
+    uint64_t* const         _times;
+    // 采样值列, 第 i 个通道为 [_values + i * _depth_max * _width_max, +_depth_max * _width_max)
+    uint8_t* const          _values;
+    // 最大通道数
+    const size_t            _channels_max;
+    // 每个通道缓存的采样点数
+    const size_t            _depth_max;
+    // 采样值的最大长度
+    const size_t            _width_max;
+
+    // 记录文件
+    int                     _fd    = -1;
+    // 通道数
+    size_t                  _count = 0;
+};
+
+/**
+ * @brief 属性值记录器(客户端)
+ *
+ * @tparam _channels 最大通道数
+ * @tparam _depth 每个通道缓存的采样点数
+ * @tparam _width 采样值的最大长度
+ */
+template <size_t _channels, size_t _depth = 256, size_t _width = 8>
+struct CRecorder : public CRecorderBase
+{
+    static_assert(_channels <= UINT16_MAX, "CRecorder has too many channels");
+    static_assert(_width <= UINT8_MAX, "CRecorder width is too large");
+
+    CRecorder()
+        : CRecorderBase(_name_buf, _width_buf, _fill_buf, &_time_buf[0][0], &_value_buf[0][0], _channels, _depth,
+                        _width)
+    {
+    }
+
+  protected:
+    std::string_view _name_buf[_channels];
+    uint8_t          _width_buf[_channels];
+    size_t           _fill_buf[_channels];
+    uint64_t         _time_buf[_channels][_depth];
+    uint8_t          _value_buf[_channels][_depth * _width];
+};
@@ -0,0 +1,173 @@
+#pragma once
+#include <CProperty.hpp>
+#include <Schema.hpp>
+
+/**
+ * @brief 由属性表描述生成的属性句柄(客户端), 直接使用属性Id, 不按名称查找
+ *
+ * @tparam T 属性值类型
+ * @tparam access 访问级别
+ */
+template <PropertyVal T, Access access>
+struct CField : public CProperty<T, access>
+{
+    using parent = CProperty<T, access>;
+
+    /**
+     * @param name 属性名称
+     * @param id 属性Id, 由 CSchema 持有, 刷新后随之更新
+     */
+    CField(const frozen::string name, const PropertyId& id)
+        : parent(name)
+        , _id(id)
+    {
+    }
+
+    ErrorCode get(HostClient& client, T& value) const
+    {
+        return parent::get(client, _id, value);
+    }
+
+    ErrorCode set(HostClient& client, const T value) const
+    {
+        return parent::set(client, _id, value);
+    }
+
+  protected:
+    const PropertyId& _id;
+};
+
+/**
+ * @brief 由属性表描述生成的属性值Id容器(客户端)
+ *
+ * @details
+ * 属性Id在编译期由描述确定; refresh 只读取 Server 的 schema 散列值,
+ * 与本机描述一致时直接使用编译期的Id, 不一致时才通过 symbols 逐个获取名称并重新映射
+ *
+ * @code
+ * static CSchema<MySchema> cschema;
+ * auto speed = cschema.field<MySchema.index("speed")>();
+ * speed.set(client, 1.0f);
+ * @endcode
+ *
+ * @tparam _schema 属性表描述
+ */
+template <const auto& _schema>
+struct CSchema : public CPropertyHolderBase
+{
+    using Desc = std::remove_cvref_t<decltype(_schema)>;
+
+    CSchema()
+    {
+        reset();
+    }
+
+    /**
+     * @brief 获取第 I 个描述的属性句柄
+     *
+     * @tparam I 描述的序号, 通常由 Schema::index 在编译期得到
+     * @return CField 属性句柄
+     */
+    template <size_t I>
+    auto field() const
+    {
+        using F = std::tuple_element_t<I, decltype(Desc::fields)>;
+        return CField<typename F::type, F::access>(std::get<I>(_schema.fields).name, _ids[I]);
+    }
+
+    /**
+     * @brief Server 的描述是否与本机一致
+     *
+     * @return true 一致, 使用编译期的Id
+     */
+    bool matched() const
+    {
+        return _matched;
+    }
+
+    virtual ErrorCode get_id_by_name(const frozen::string name, PropertyId& id) const override
+    {
+        for (size_t i = 0; i < Desc::SIZE; i++)
+        {
+            if (!(_schema.name(i) == name)) continue;
+            id = _ids[i];
+            return ErrorCode::S_OK;
+        }
+        return ErrorCode::E_ID_NOT_EXIST;
+    }
+
+    virtual ErrorCode refresh(HostClient& client) override
+    {
+        ErrorCode err;
+        Extra&    extra = client.extra;
+
+        // 比较描述的散列值
+        extra.reset();
+        extra.add<PropertyId>(1);
+        client.send(Command::GET_PROPERTY, extra, false);
+        if (!client.recv_response(Command::GET_PROPERTY, err, extra)) return ErrorCode::E_TIMEOUT;
+
+        uint32_t hash;
+        _matched = err == ErrorCode::S_OK && extra.remain() == sizeof(hash) && extra.get(hash) &&
+                   hash == _schema.hash();
+        reset();
+        if (_matched) return ErrorCode::S_OK;
+
+        // 描述不一致, 通过 symbols 重新映射
+        Size size;
+        extra.reset();
+        extra.add<PropertyId>(0);
+        client.send(Command::GET_SIZE, extra, false);
+        if (!client.recv_response(Command::GET_SIZE, err, extra)) return ErrorCode::E_TIMEOUT;
+        if (err != ErrorCode::S_OK) return err;
+        if (!extra.get(size)) return ErrorCode::E_FAIL;
+
+        for (size_t i = 0; i < Desc::SIZE; i++)
+            _ids[i] = UINT16_MAX;
+
+        size_t found = 0;
+        for (Size id = 0; id < size; id++)
+        {
+            if (get_name(client, id, false) != ErrorCode::S_OK)
+            {
+                // 使用加密模式再获取一次
+                if (get_name(client, id, true) != ErrorCode::S_OK) continue;
+                if (!extra.decrypt(client.secret.nonce, client.secret.key, client.cipher())) continue;
+            }
+
+            frozen::string name((const char*)extra.curr(), (size_t)extra.remain());
+            for (size_t i = 0; i < Desc::SIZE; i++)
+            {
+                if (_ids[i] != UINT16_MAX || !(_schema.name(i) == name)) continue;
+                _ids[i] = id;
+                found++;
+                break;
+            }
+        }
+        return found == Desc::SIZE ? ErrorCode::S_OK : ErrorCode::E_FAIL;
+    }
+
+  protected:
+    void reset()
+    {
+        for (size_t i = 0; i < Desc::SIZE; i++)
+            _ids[i] = i + Desc::FIRST;
+    }
+
+    static ErrorCode get_name(HostClient& client, PropertyId id, bool encrypted)
+    {
+        ErrorCode err;
+        Extra&    extra = client.extra;
+
+        extra.reset();
+        extra.add<PropertyId>(0);
+        extra.add<PropertyId>(id);
+        client.send(Command::GET_PROPERTY, extra, encrypted);
+        if (!client.recv_response(Command::GET_PROPERTY, err, extra)) return ErrorCode::E_TIMEOUT;
+        return err;
+    }
+
+  protected:
+    PropertyId _ids[Desc::SIZE];
+    bool       _matched = false;
+};
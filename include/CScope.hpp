@@ -0,0 +1,128 @@
+#pragma once
+#include <HostClient.hpp>
+#include <initializer_list>
+
+/**
+ * @brief 示波器模式的接收器(客户端)
+ *
+ * @details
+ * start 配置 Server 采样的属性和分频系数, 之后 Server 持续发送 SCOPE_DATA 帧;
+ * 接收到的采样数据按通道拆分为列, 第 i 个通道的第 k 个采样值位于 column(i) + k * width(i)
+ *
+ * @note 需要设置 HostClient::scope, 采样数据在 recv_response 或 dispatch 中写入
+ * @note 列存满后新的采样点被丢弃, 调用 clear 重新开始
+ */
+struct CScopeBase
+{
+    ErrorCode      start(HostClient& client, std::initializer_list<frozen::string> names, uint16_t divider);
+    ErrorCode      stop(HostClient& client);
+    void           receive(Extra& extra);
+    void           clear();
+    const uint8_t* column(size_t channel) const;
+
+    /**
+     * @brief 获取指定类型的列
+     *
+     * @tparam T 采样值类型
+     * @param channel 通道
+     * @return const T* 列的首地址, 类型长度与采样值长度不一致时为空
+     */
+    template <PropertyVal T>
+    const T* column(size_t channel) const
+    {
+        if (channel >= _count || sizeof(T) != _widths[channel]) return nullptr;
+        return (const T*)column(channel);
+    }
+
+    /**
+     * @brief 获取通道数
+     *
+     * @return size_t 通道数
+     */
+    size_t channels() const
+    {
+        return _count;
+    }
+
+    /**
+     * @brief 获取通道采样值的长度
+     *
+     * @param channel 通道
+     * @return Size 采样值长度
+     */
+    Size width(size_t channel) const
+    {
+        return _widths[channel];
+    }
+
+    /**
+     * @brief 获取已接收的采样点数
+     *
+     * @return size_t 采样点数
+     */
+    size_t size() const
+    {
+        return _size;
+    }
+
+    /**
+     * @brief 获取根据块序号检测到的丢失块数
+     *
+     * @return uint32_t 丢失的块数
+     */
+    uint32_t lost() const
+    {
+        return _lost;
+    }
+
+  protected:
+    CScopeBase(uint8_t* columns, uint8_t* widths, size_t channels, size_t depth)
+        : _columns(columns)
+        , _widths(widths)
+        , _channels_max(channels)
+        , _depth_max(depth)
+    {
+    }
+
+  protected:
+    // 列存储区, 每列 _depth_max * SCOPE_WIDTH_MAX 字节
+    uint8_t* const _columns;
+    // 各通道采样值的长度
+    uint8_t* const _widths;
+    // 最大通道数
+    const size_t   _channels_max;
+    // 每列最多保存的采样点数
+    const size_t   _depth_max;
+
+    // 通道数
+    size_t         _count  = 0;
+    // 每个采样点的长度
+    Size           _row    = 0;
+    // 已接收的采样点数
+    size_t         _size   = 0;
+    // 期望的下一个块序号
+    uint16_t       _next   = 0;
+    // 是否已收到第一块
+    bool           _synced = false;
+    // 丢失的块数
+    uint32_t       _lost   = 0;
+};
+
+/**
+ * @brief 示波器模式的接收器(客户端)
+ *
+ * @tparam _channels 最大通道数
+ * @tparam _depth 每列最多保存的采样点数
+ */
+template <size_t _channels, size_t _depth>
+struct CScope : public CScopeBase
+{
+    CScope()
+        : CScopeBase(&_column_buf[0][0], _width_buf, _channels, _depth)
+    {
+    }
+
+  protected:
+    alignas(8) uint8_t _column_buf[_channels][_depth * SCOPE_WIDTH_MAX];
+    uint8_t            _width_buf[_channels];
+};
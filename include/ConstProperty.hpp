@@ -0,0 +1,122 @@
+#pragma once
+#include <array>
+#include <bit>
+#include <Crc.hpp>
+#include <PropertyBase.hpp>
+
+/**
+ * @brief 不可变属性, 如固件版本和常量
+ *
+ * @details
+ * 构造时生成完整的 GET_PROPERTY 应答帧(帧头, 帧头校验和, 属性值, 附加参数校验和);
+ * 声明为 constexpr 时应答帧在编译期生成并存放在只读存储区, Server 以一次 tx 发送, 不再序列化和计算校验和
+ *
+ * @note 应答帧只在本机地址与构造时的地址一致, 且链路使用 CRC16 时使用, 否则按普通属性应答
+ *
+ * @tparam _size 属性值长度
+ */
+template <size_t _size>
+struct ConstProperty : public PropertyAccess<Access::READ>
+{
+    static_assert(_size > 0 && _size <= UINT16_MAX, "ConstProperty size is invalid");
+
+    // 属性值在应答帧中的偏移
+    static constexpr size_t HEAD  = sizeof(Header) + sizeof(Checksum);
+    // 应答帧长度
+    static constexpr size_t FRAME = HEAD + _size + sizeof(Checksum);
+
+    /**
+     * @param value 属性值
+     * @param address 本机地址
+     */
+    template <PropertyVal T>
+        requires(sizeof(T) == _size && std::is_trivially_copyable_v<T>)
+    constexpr ConstProperty(const T& value, Address address)
+        : _frame(build(std::bit_cast<std::array<uint8_t, _size>>(value), address))
+    {
+    }
+
+    /**
+     * @param str 字符串, 不含结尾的 '\0'
+     * @param address 本机地址
+     */
+    constexpr ConstProperty(const char (&str)[_size + 1], Address address)
+        : _frame(build(
+              [&str]()
+              {
+                  std::array<uint8_t, _size> payload {};
+                  for (size_t i = 0; i < _size; i++)
+                      payload[i] = str[i];
+                  return payload;
+              }(),
+              address))
+    {
+    }
+
+    virtual ErrorCode get(Extra& extra, bool) const override
+    {
+        extra.reset();
+        if (!extra.add(&_frame[HEAD], _size)) return ErrorCode::E_OUT_OF_BUFFER;
+        return ErrorCode::S_OK;
+    }
+
+    virtual ErrorCode get_view(Extra&, bool, const uint8_t*& data, Size& size) const override
+    {
+        data = &_frame[HEAD];
+        size = _size;
+        return ErrorCode::S_OK;
+    }
+
+    virtual ErrorCode get_frame(Address address, const uint8_t*& frame, size_t& size) const override
+    {
+        if (address != _frame[0]) return ErrorCode::E_NO_IMPLEMENT;
+        frame = _frame.data();
+        size  = _frame.size();
+        return ErrorCode::S_OK;
+    }
+
+    virtual ErrorCode get_size(Extra& extra, bool) const override
+    {
+        extra.reset();
+        extra.add<Size>(_size);
+        return ErrorCode::S_OK;
+    }
+
+    virtual Size sample(uint8_t* buf) const override
+    {
+        if (buf) memcpy(buf, &_frame[HEAD], _size);
+        return _size;
+    }
+
+  protected:
+    static constexpr std::array<uint8_t, FRAME> build(const std::array<uint8_t, _size>& payload, Address address)
+    {
+        std::array<uint8_t, FRAME> frame {};
+        // 帧头, 字段按小端排列
+        frame[0]     = address;
+        frame[1]     = (uint8_t)Command::GET_PROPERTY;
+        frame[2]     = _size & 0xFF;
+        frame[3]     = _size >> 8;
+        frame[4]     = (uint8_t)ErrorCode::S_OK;
+        // 与 HostBase::send 一致, 校验和高字节在前
+        uint16_t crc = crc16_ccitt(frame.data(), sizeof(Header));
+        frame[5]     = crc >> 8;
+        frame[6]     = crc & 0xFF;
+
+        for (size_t i = 0; i < _size; i++)
+            frame[HEAD + i] = payload[i];
+        crc               = crc16_ccitt(&frame[HEAD], _size);
+        frame[FRAME - 2]  = crc >> 8;
+        frame[FRAME - 1]  = crc & 0xFF;
+        return frame;
+    }
+
+  protected:
+    const std::array<uint8_t, FRAME> _frame;
+};
+
+template <PropertyVal T>
+ConstProperty(const T&, Address) -> ConstProperty<sizeof(T)>;
+
+template <size_t N>
+ConstProperty(const char (&)[N], Address) -> ConstProperty<N - 1>;
@@ -0,0 +1,108 @@
+#pragma once
+#include <checksum.h>
+#include <Extra.hpp>
+
+/**
+ * @brief 编译期计算 CRC16-CCITT-False
+ *
+ * @note 结果与 libcrc 的 crc_ccitt_ffff 一致, 运行时应当使用查表的 libcrc
+ *
+ * @param data 数据
+ * @param size 数据长度
+ * @param crc 初值
+ * @return uint16_t 校验和
+ */
+constexpr uint16_t crc16_ccitt(const uint8_t* data, size_t size, uint16_t crc = CRC_START_CCITT_FFFF)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        crc ^= data[i] << 8;
+        for (size_t j = 0; j < 8; j++)
+            crc = crc & 0x8000 ? (crc << 1) ^ CRC_POLY_CCITT : crc << 1;
+    }
+    return crc;
+}
+
+/**
+ * @brief 分段计算内存区的校验和
+ *
+ * @note 结果与 libcrc 的 crc_32/crc_64_ecma 一致
+ */
+struct Crc
+{
+    Crc(CrcType type)
+        : _type(type)
+        , _value(type == CrcType::CRC32 ? CRC_START_32 : CRC_START_64_ECMA)
+    {
+    }
+
+    /**
+     * @brief 追加数据
+     *
+     * @param data 数据
+     * @param size 数据长度
+     */
+    void update(const void* data, size_t size)
+    {
+        const uint8_t* ptr = (const uint8_t*)data;
+        if (_type == CrcType::CRC32)
+        {
+            for (size_t i = 0; i < size; i++)
+                _value = (_value >> 8) ^ crc_tab32[(_value ^ ptr[i]) & 0xFF];
+        }
+        else
+        {
+            for (size_t i = 0; i < size; i++)
+                _value = (_value << 8) ^ crc_tab64[((_value >> 56) ^ ptr[i]) & 0xFF];
+        }
+    }
+
+    /**
+     * @brief 获取校验和
+     *
+     * @return uint64_t 校验和
+     */
+    uint64_t value() const
+    {
+        if (_type == CrcType::CRC32) return (uint32_t)(_value ^ 0xFFFFFFFFul);
+        return _value;
+    }
+
+    /**
+     * @brief 将校验和添加到缓冲区
+     *
+     * @param extra 缓冲区
+     * @return true 添加成功
+     * @return false 缓冲区长度不足
+     */
+    bool add(Extra& extra) const
+    {
+        if (_type == CrcType::CRC32) return extra.add<uint32_t>(value());
+        return extra.add<uint64_t>(value());
+    }
+
+    /**
+     * @brief 从缓冲区中读取校验和
+     *
+     * @param extra 缓冲区
+     * @param type 校验和类型
+     * @param value 校验和
+     * @return true 成功读取
+     * @return false 缓冲区长度不足
+     */
+    static bool get(Extra& extra, CrcType type, uint64_t& value)
+    {
+        if (type == CrcType::CRC64) return extra.get(value);
+
+        uint32_t crc;
+        if (!extra.get(crc)) return false;
+        value = crc;
+        return true;
+    }
+
+  protected:
+    // 校验和类型
+    CrcType  _type;
+    // 当前的校验和
+    uint64_t _value;
+};
@@ -0,0 +1,46 @@
+#pragma once
+#include <cstddef>
+#include <stdint.h>
+
+/**
+ * @brief 计算 CRC-32C(Castagnoli) 校验和
+ *
+ * @note x86 平台在运行时检测 SSE4.2, 支持时使用 crc32 指令, 否则使用查表法
+ * @note 支持分段计算: crc32c(crc32c(0, a), b) == crc32c(0, a + b)
+ *
+ * @param crc 上一段的校验和, 首段为 0
+ * @param data 数据
+ * @param size 数据长度
+ * @return uint32_t 校验和
+ */
+uint32_t crc32c(uint32_t crc, const void* data, size_t size);
+
+/**
+ * @brief 使用查表法计算 CRC-32C 校验和
+ *
+ * @param crc 上一段的校验和, 首段为 0
+ * @param data 数据
+ * @param size 数据长度
+ * @return uint32_t 校验和
+ */
+uint32_t crc32c_sw(uint32_t crc, const void* data, size_t size);
+
+/**
+ * @brief 使用 SSE4.2 指令计算 CRC-32C 校验和
+ *
+ * @note 仅在 crc32c_hw_supported() 返回 true 时可用
+ *
+ * @param crc 上一段的校验和, 首段为 0
+ * @param data 数据
+ * @param size 数据长度
+ * @return uint32_t 校验和
+ */
+uint32_t crc32c_hw(uint32_t crc, const void* data, size_t size);
+
+/**
+ * @brief 当前平台是否支持硬件计算 CRC-32C
+ *
+ * @return true 支持
+ * @return false 不支持
+ */
+bool     crc32c_hw_supported();
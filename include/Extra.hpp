@@ -1,12 +1,14 @@
 #pragma once
+#include <Aead.hpp>
 #include <string.h>
-#include <uaes.h>
 
 #include <Types.hpp>
 
 template <size_t _size>
 struct ExtraT
 {
+    static_assert(_size <= UINT16_MAX, "Extra size must fit in Size");
+
   public:
     /**
      * @brief 向缓冲区中添加指定类型的数据
@@ -78,10 +80,11 @@ struct ExtraT
      *
      * @param nonce 加密数据的随机数
      * @param key 加密数据的密钥
+     * @param suite 加密套件
      * @return true 解密成功
      * @return false 解密失败
      */
-    bool decrypt(const NonceType& nonce, const KeyType& key)
+    bool decrypt(const NonceType& nonce, const KeyType& key, const CipherSuite& suite = {})
     {
         // 不能重复解密
         if (!encrypted()) return false;
@@ -89,17 +92,7 @@ struct ExtraT
         // 数据长度至少为 1
         if (size() == 0) return false;
 
-        if (!UAES_CCM_SimpleDecrypt(key.data(),
-                                    key.size(),
-                                    nonce.data(),
-                                    nonce.size(),
-                                    NULL,
-                                    0,
-                                    data(),
-                                    data(),
-                                    size(),
-                                    tag(),
-                                    sizeof(TagType)))
+        if (!aead_decrypt(suite, key, nonce, data(), size(), tag(suite.tag_size())))
         {
             reset();
             return false;
@@ -112,8 +105,9 @@ struct ExtraT
      *
      * @param nonce 加密数据的随机数
      * @param key 加密数据的密钥
+     * @param suite 加密套件
      */
-    void encrypt(const NonceType& nonce, const KeyType& key)
+    void encrypt(const NonceType& nonce, const KeyType& key, const CipherSuite& suite = {})
     {
         // 数据长度至少为 1
         if (size() == 0) return;
@@ -121,17 +115,7 @@ struct ExtraT
         if (encrypted()) return;
         encrypted() = true;
 
-        UAES_CCM_SimpleEncrypt(key.data(),
-                               key.size(),
-                               nonce.data(),
-                               nonce.size(),
-                               NULL,
-                               0,
-                               data(),
-                               data(),
-                               size(),
-                               tag(),
-                               sizeof(TagType));
+        aead_encrypt(suite, key, nonce, data(), size(), tag(suite.tag_size()));
     }
 
     /**
@@ -159,11 +143,14 @@ struct ExtraT
     /**
      * @brief 返回 tag的首地址
      *
+     * @note 较短的 tag 存放在 Tag区末尾, 与数据区相连, 以便连续发送
+     *
+     * @param size tag 长度
      * @return uint8_t* tag的首地址
      */
-    uint8_t* tag()
+    uint8_t* tag(size_t size = sizeof(TagType))
     {
-        return _tag.data();
+        return _tag.data() + sizeof(TagType) - size;
     }
 
     /**
@@ -13,6 +13,8 @@ enum PopAction
 template <size_t _size, PopAction action = PopAction::NoPop>
 struct FixedQueue
 {
+    static_assert(_size < UINT32_MAX, "FixedQueue is too large");
+
     /**
      * @brief 复位队列
      *
@@ -136,7 +138,7 @@ struct FixedQueue
     // 需要额外占用一个元素来表示队列满
     std::array<uint8_t, (_size + 1)> _buf;
     // 指向空数据
-    volatile size_t                  _empty = 0;
+    volatile uint32_t                _empty = 0;
     // 指向有效数据
-    volatile size_t                  _data  = 0;
+    volatile uint32_t                _data  = 0;
 };
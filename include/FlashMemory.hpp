@@ -0,0 +1,232 @@
+#pragma once
+#include "PropertyBase.hpp"
+#include <Crc.hpp>
+#include <algorithm>
+
+/**
+ * @brief 闪存驱动接口
+ *
+ * @note 地址均为闪存的绝对地址
+ */
+struct FlashDriver
+{
+    /**
+     * @brief 读取闪存
+     *
+     * @param addr 起始地址
+     * @param buf 接收数据的缓冲区
+     * @param size 数据长度
+     * @return ErrorCode 错误码
+     */
+    virtual ErrorCode read(size_t addr, void* buf, size_t size)          = 0;
+    /**
+     * @brief 擦除一页闪存
+     *
+     * @param addr 页的起始地址
+     * @return ErrorCode 错误码
+     */
+    virtual ErrorCode erase(size_t addr)                                 = 0;
+    /**
+     * @brief 写入闪存, 写入前对应的页已被擦除
+     *
+     * @param addr 起始地址
+     * @param buf 要写入的数据
+     * @param size 数据长度
+     * @return ErrorCode 错误码
+     */
+    virtual ErrorCode program(size_t addr, const void* buf, size_t size) = 0;
+};
+
+/**
+ * @brief 闪存内存区属性
+ *
+ * @details
+ * 写入的数据先缓存在页缓存中, 连续的分块写入会被合并;
+ * 当写入到达页末尾, 写入其他页, 或者收到 COMMIT 命令时, 才会擦除并写入闪存
+ *
+ * @note 未提交的数据会在读取时返回, 但掉电后会丢失
+ *
+ * @tparam T 标准布局类型
+ * @tparam _page 闪存页大小
+ * @tparam access 访问级别
+ */
+template <PropertyVal T, size_t _page, Access _access = Access::READ>
+struct FlashMemory : public PropertyAccess<_access>
+{
+    FlashMemory(FlashDriver& driver, size_t base)
+        : _driver(driver)
+        , _base(base)
+    {
+    }
+
+    virtual ErrorCode set(Extra& extra, bool) override
+    {
+        MemoryAccess access;
+        // 检查访问参数是否正确
+        if (!extra.get(access) || access.size != extra.remain()) return ErrorCode::E_INVALID_ARG;
+        // 检查是否超出内存区范围
+        if (sizeof(T) < access.offset + access.size) return ErrorCode::E_OUT_OF_INDEX;
+
+        size_t         addr = _base + access.offset;
+        const uint8_t* data = extra.curr();
+        size_t         size = access.size;
+        while (size > 0)
+        {
+            size_t page = addr - addr % _page;
+            size_t len  = std::min(size, page + _page - addr);
+
+            ErrorCode err;
+            if ((err = load(page)) != ErrorCode::S_OK) return err;
+            memcpy(&_cache[addr - page], data, len);
+            _dirty = true;
+            // 写满一页后立即提交
+            if (addr + len == page + _page && (err = flush()) != ErrorCode::S_OK) return err;
+
+            addr += len;
+            data += len;
+            size -= len;
+        }
+        extra.reset();
+        return ErrorCode::S_OK;
+    }
+
+    virtual ErrorCode get(Extra& extra, bool) const override
+    {
+        MemoryAccess access;
+        // 检查访问参数是否正确
+        if (!extra.get(access)) return ErrorCode::E_INVALID_ARG;
+        // 检查是否超出内存区范围
+        if (sizeof(T) < access.offset + access.size) return ErrorCode::E_OUT_OF_INDEX;
+        extra.reset();
+        if (access.size > extra.spare()) return ErrorCode::E_OUT_OF_BUFFER;
+
+        ErrorCode err;
+        if ((err = read(access.offset, extra.curr(), access.size)) != ErrorCode::S_OK)
+        {
+            extra.reset();
+            return err;
+        }
+        extra.seek(access.size);
+        return ErrorCode::S_OK;
+    }
+
+    virtual ErrorCode get_crc(Extra& extra, bool) const override
+    {
+        MemoryAccess access;
+        CrcType      type;
+        // 检查访问参数是否正确
+        if (!extra.get(access) || !extra.get(type)) return ErrorCode::E_INVALID_ARG;
+        if (type != CrcType::CRC32 && type != CrcType::CRC64) return ErrorCode::E_INVALID_ARG;
+        // 检查是否超出内存区范围
+        if (sizeof(T) < access.offset + access.size) return ErrorCode::E_OUT_OF_INDEX;
+        extra.reset();
+
+        // 借用附加参数缓冲区分段读取
+        Crc  crc(type);
+        Size offset = access.offset;
+        Size remain = access.size;
+        while (remain > 0)
+        {
+            Size      len = std::min(remain, extra.capacity());
+            ErrorCode err;
+            if ((err = read(offset, extra.data(), len)) != ErrorCode::S_OK) return err;
+            crc.update(extra.data(), len);
+            offset += len;
+            remain -= len;
+        }
+        crc.add(extra);
+        return ErrorCode::S_OK;
+    }
+
+    virtual ErrorCode get_size(Extra& extra, bool) const override
+    {
+        extra.reset();
+        extra.add<Size>(sizeof(T));
+        return ErrorCode::S_OK;
+    }
+
+    virtual ErrorCode commit(Extra& extra, bool) override
+    {
+        extra.reset();
+        return flush();
+    }
+
+    /**
+     * @brief 读取内存区, 包含尚未提交的数据
+     *
+     * @param offset 相对内存区的偏移
+     * @param buf 接收数据的缓冲区
+     * @param size 数据长度
+     * @return ErrorCode 错误码
+     */
+    ErrorCode read(size_t offset, void* buf, size_t size) const
+    {
+        size_t   addr = _base + offset;
+        uint8_t* data = (uint8_t*)buf;
+        while (size > 0)
+        {
+            size_t page = addr - addr % _page;
+            size_t len  = std::min(size, page + _page - addr);
+
+            if (page == _page_addr)
+                memcpy(data, &_cache[addr - page], len);
+            else
+            {
+                ErrorCode err;
+                if ((err = _driver.read(addr, data, len)) != ErrorCode::S_OK) return err;
+            }
+
+            addr += len;
+            data += len;
+            size -= len;
+        }
+        return ErrorCode::S_OK;
+    }
+
+    /**
+     * @brief 将页缓存写入闪存
+     *
+     * @return ErrorCode 错误码
+     */
+    ErrorCode flush()
+    {
+        if (!_dirty) return ErrorCode::S_OK;
+        if (_driver.erase(_page_addr) != ErrorCode::S_OK) return ErrorCode::E_BAD_BLOCK;
+        if (_driver.program(_page_addr, _cache.data(), _page) != ErrorCode::S_OK) return ErrorCode::E_BAD_BLOCK;
+        _dirty = false;
+        return ErrorCode::S_OK;
+    }
+
+  protected:
+    /**
+     * @brief 将指定页载入页缓存
+     *
+     * @param page 页的起始地址
+     * @return ErrorCode 错误码
+     */
+    ErrorCode load(size_t page)
+    {
+        if (page == _page_addr) return ErrorCode::S_OK;
+
+        ErrorCode err;
+        // 先提交当前的页
+        if ((err = flush()) != ErrorCode::S_OK) return err;
+        // 页中不属于内存区的数据也需要保留
+        _page_addr = SIZE_MAX;
+        if ((err = _driver.read(page, _cache.data(), _page)) != ErrorCode::S_OK) return err;
+        _page_addr = page;
+        return ErrorCode::S_OK;
+    }
+
+  protected:
+    // 闪存驱动
+    FlashDriver&               _driver;
+    // 内存区的起始地址
+    const size_t               _base;
+    // 缓存的页的起始地址
+    size_t                     _page_addr = SIZE_MAX;
+    // 页缓存是否有未提交的数据
+    bool                       _dirty     = false;
+    // 页缓存
+    std::array<uint8_t, _page> _cache;
+};
@@ -1,5 +1,6 @@
 #pragma once
 #include <FixedQueue.hpp>
+#include <Lock.hpp>
 #include <Property.hpp>
 
 template <typename T>
@@ -77,6 +78,33 @@ struct SecretHolder
 
 using PropertyAddress = Property<Address>;
 
+/**
+ * @brief 直接接收缓冲区
+ *
+ * @note 命令一致, 执行成功, 未加密且长度一致的数据帧, 其附加参数将直接写入此缓冲区, 不经过 Extra
+ */
+struct DirectBuffer
+{
+    Command  cmd;  // 期望的命令
+    uint8_t* data; // 缓冲区
+    Size     size; // 缓冲区长度
+    bool     used; // [out]附加参数是否已写入缓冲区
+};
+
+/**
+ * @brief 接收统计
+ *
+ */
+struct LinkStats
+{
+    uint32_t frames;   // 接收到的本机帧数
+    uint32_t foreign;  // 跳过的其他地址的帧数
+    uint32_t skipped;  // 跳过的字节数
+    uint32_t oversize; // 超出附加参数缓冲区而被拒绝的帧数
+    uint32_t checksum; // 附加参数校验失败的帧数
+    uint32_t noise;    // 帧同步时丢弃的字节数, 总线冲突时增加
+};
+
 struct HostBase
 {
     // 从机地址
@@ -84,14 +112,46 @@ struct HostBase
     // 密钥容器
     SecretHolder& secret;
 
-    HostBase(Address& address, SecretHolder& secret)
+    /**
+     * @param address 从机地址
+     * @param secret 密钥容器
+     * @param tx_lock 发送锁, 多个任务发送数据帧时用于保证帧的完整性
+     */
+    HostBase(Address& address, SecretHolder& secret, Lock& tx_lock = no_lock)
         : address(address)
         , secret(secret)
+        , _tx_lock(tx_lock)
     {
     }
 
     void send(Command cmd, Extra& extra, bool encrypt = false, ErrorCode err = ErrorCode::S_OK);
-    bool recv(Command& cmd, ErrorCode& err, Extra& extra);
+    void send_to(Address target, Command cmd, Extra& extra, bool encrypt = false, ErrorCode err = ErrorCode::S_OK);
+    void send_direct(Command cmd, const void* data, Size size, ErrorCode err = ErrorCode::S_OK);
+    bool recv(Command& cmd, ErrorCode& err, Extra& extra, DirectBuffer* direct = nullptr);
+
+    /**
+     * @brief 获取接收统计
+     *
+     * @return const LinkStats& 接收统计
+     */
+    const LinkStats& stats() const
+    {
+        return _stats;
+    }
+
+    /**
+     * @brief 获取当前链路的加密套件
+     *
+     * @return const CipherSuite& 加密套件
+     */
+    const CipherSuite& cipher() const
+    {
+        return _cipher;
+    }
+
+    ErrorCode check_link(LinkOption option, uint8_t value) const;
+    void      apply_link(LinkOption option, uint8_t value);
+    void      default_link();
 
   protected:
     /**
@@ -108,11 +168,39 @@ struct HostBase
      * @param size 数据的长度
      */
     virtual void tx(const void* buf, size_t size) = 0;
+    /**
+     * @brief 丢弃接收到的字节, 默认逐字节调用 rx
+     *
+     * @note 使用 DMA 环形缓冲区的传输层可以直接移动读指针
+     *
+     * @param size 丢弃的字节数
+     * @return 是否接收成功
+     */
+    virtual bool skip(size_t size);
+    /**
+     * @brief 是否接收发往目标地址的帧, 默认只接收本机地址
+     *
+     * @param target 帧头中的地址
+     * @return true 接收
+     * @return false 跳过
+     */
+    virtual bool accepts(Address target) const;
 
   protected:
     void send(const Header& head, const void* extra, Size size);
+    void send_frame(const void* frame, size_t size);
     bool sync(Header& head);
 
   protected:
+    // 发送锁
+    Lock&        _tx_lock;
     Sync<Header> _buf_head;
+    // 附加参数校验和类型
+    ChecksumType _checksum = ChecksumType::CRC16;
+    // 加密套件
+    CipherSuite  _cipher;
+    // 最近接收的帧的目标地址
+    Address      _target   = 0;
+    // 接收统计
+    LinkStats    _stats    = {};
 };
@@ -1,5 +1,6 @@
 #pragma once
 #include "Types.hpp"
+#include <AsyncQueue.hpp>
 #include <Extra.hpp>
 #include <FixedQueue.hpp>
 #include <frozen/map.h>
@@ -10,6 +11,9 @@ template <size_t _size>
 using CPropertyMap = frozen::map<frozen::string, PropertyId, _size>;
 
 struct HostClient;
+struct CLogFormatsBase;
+struct CScopeBase;
+struct CRecorderBase;
 
 struct CPropertyHolderBase
 {
@@ -40,21 +44,52 @@ struct HostClient : public HostBase
     Extra                extra;
     // 属性值Id容器
     CPropertyHolderBase& holder;
+    // Server 的通信能力, 协商前为本机的默认值
+    Capability           capability;
+    // 日志格式表, 为空时二进制日志不展开, 原样输出
+    CLogFormatsBase*     formats  = nullptr;
+    // 异步帧队列, 为空时在 recv_response 中直接处理异步帧
+    AsyncQueueBase*      async    = nullptr;
+    // 示波器模式的接收器, 为空时丢弃采样数据
+    CScopeBase*          scope    = nullptr;
+    // 属性值记录器, 为空时不记录
+    CRecorderBase*       recorder = nullptr;
 
     HostClient(Address& address, CPropertyHolderBase& holder, SecretHolder& secret)
         : HostBase(address, secret)
         , holder(holder)
     {
+        capability.capacity = extra.capacity();
+        capability.memory   = MEMORY_ACCESS_SIZE_MAX;
+        capability.features = 0;
     }
 
-    bool recv_response(Command cmd, ErrorCode& err, Extra& extra);
+    bool      recv_response(Command cmd, ErrorCode& err, Extra& extra, DirectBuffer* direct = nullptr);
+    ErrorCode negotiate();
+    ErrorCode set_link(LinkOption option, uint8_t value);
+    ErrorCode reset_link();
+    Size      memory_access_size() const;
+    bool      dispatch();
+    void      record(const frozen::string name, const void* value, Size size);
 
   protected:
+    virtual bool accepts(Address target) const override;
+    static bool  is_async(Command cmd);
+    void         handle_async(Command cmd, Extra& extra);
+    void         output(uint8_t level, const uint8_t* log, size_t size);
+
     /**
      * @brief 日志输出接口
      *
+     * @note 二进制日志未展开时, level 带有 LOG_BINARY 标记
+     *
+     * @param level 日志等级
      * @param log 日志信息
      * @param size 日志字节长度
      */
     virtual void log_output(LogLevel level, const uint8_t* log, size_t size) = 0;
+
+  protected:
+    // 消费者处理异步帧时使用的附加参数缓冲区
+    Extra _async_extra;
 };
@@ -0,0 +1,120 @@
+#pragma once
+#include <HostServer.hpp>
+
+/**
+ * @brief 传输层接口, 一个物理链路(UART/USB-CDC/CAN 桥等)
+ *
+ */
+struct Transport
+{
+    /**
+     * @brief 非阻塞地接收 1 字节数据
+     *
+     * @param byte 接收数据的变量
+     * @return true 接收成功
+     * @return false 暂无数据, 立即返回
+     */
+    virtual bool rx(uint8_t& byte)                = 0;
+    /**
+     * @brief 阻塞地发送任意长度字节
+     *
+     * @param buf 要发送的数据
+     * @param size 数据的长度
+     */
+    virtual void tx(const void* buf, size_t size) = 0;
+};
+
+/**
+ * @brief 链路端点, 在一个传输层上运行协议引擎
+ *
+ * @details
+ * 多个端点共享同一个属性值容器和属性锁, 各自拥有帧解析状态, 附加参数缓冲区, 密钥容器和链路参数;
+ * pump 从传输层读取可用的字节并逐步解析, 凑齐一帧后才交给 HostServer::poll 处理, 因此不会阻塞在半帧上.
+ * 其他地址的帧在解析时直接丢弃, 不会唤醒协议引擎
+ *
+ * @note 暂存区保存一个完整的请求帧, 每个端点额外占用约一个附加参数缓冲区的内存
+ */
+struct HostLink : public HostServer
+{
+    // 暂存区长度: 帧头, 帧头校验和, tag, 附加参数, 附加参数校验和
+    static constexpr size_t STAGE = sizeof(Header) + sizeof(Checksum) + sizeof(TagType) +
+                                    MEMORY_ACCESS_SIZE_MAX + sizeof(PropertyId) + sizeof(MemoryAccess) +
+                                    sizeof(uint32_t);
+
+    /**
+     * @param transport 传输层
+     * @param address 从机地址
+     * @param holder 属性值容器, 可由多个端点共享
+     * @param secret 密钥容器, 每个端点独立的随机数/会话
+     * @param tx_lock 发送锁, 在其他任务中向此端点 log 时需要
+     * @param prop_lock 属性锁, 端点在不同任务中轮询时应当共享同一个属性锁
+     */
+    HostLink(Transport& transport, Address& address, const PropertyHolderBase& holder, SecretHolder& secret,
+             Lock& tx_lock = no_lock, Lock& prop_lock = no_lock)
+        : HostServer(address, holder, secret, tx_lock, prop_lock)
+        , _transport(transport)
+    {
+    }
+
+    bool pump(size_t budget);
+    bool ready() const;
+    bool poll();
+
+  protected:
+    virtual bool rx(uint8_t& byte) override;
+    virtual void tx(const void* buf, size_t size) override;
+    virtual bool skip(size_t size) override;
+
+  protected:
+    enum class State : uint8_t
+    {
+        HEAD, // 帧同步
+        BODY, // 接收附加参数
+        SKIP, // 丢弃附加参数
+    };
+
+    // 传输层
+    Transport&                  _transport;
+    // 帧头同步缓冲区
+    Sync<Header>                _sync;
+    // 解析状态
+    State                       _state  = State::HEAD;
+    // 已凑齐一帧
+    bool                        _ready  = false;
+    // 当前状态剩余的字节数
+    size_t                      _remain = 0;
+    // 暂存区的数据长度
+    size_t                      _staged = 0;
+    // 暂存区的读取位置
+    size_t                      _pos    = 0;
+    // 暂存区
+    std::array<uint8_t, STAGE>  _stage;
+};
+
+/**
+ * @brief 多个链路端点的轮询调度
+ *
+ * @details
+ * 每轮从上一轮的下一个端点开始, 每个端点最多读取 budget 字节并处理一帧,
+ * 持续发送的链路不会使其他链路饿死
+ */
+struct HostLinks
+{
+    /**
+     * @param links 端点数组
+     * @param size 端点个数
+     */
+    HostLinks(HostLink* const* links, size_t size)
+        : _links(links)
+        , _size(size)
+    {
+    }
+
+    size_t poll(size_t budget = 64);
+
+  protected:
+    HostLink* const* _links;
+    size_t           _size;
+    // 下一轮首先服务的端点
+    size_t           _next = 0;
+};
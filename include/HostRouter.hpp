@@ -0,0 +1,113 @@
+#pragma once
+#include <HostBase.hpp>
+
+/**
+ * @brief 路由及其下游链路
+ *
+ */
+struct RouteLink
+{
+    // 地址映射
+    Route     route;
+    // 下游链路, 由固件实现 rx/tx, 其地址在转发时被改写为目标设备的下游地址
+    HostBase* link;
+};
+
+/**
+ * @brief 路由器, 将上游发往路由地址的帧转发到下游总线, 并将应答转换地址后转发回上游
+ *
+ * @details
+ * HostServer 在 poll 中将路由地址的帧原样放入转发队列后立即返回, 不等待下游应答;
+ * pump 在下游任务中逐帧取出, 发送到下游链路并等待应答, 期间下游设备的异步帧也转换地址后转发;
+ * 下游超时时以 E_TIMEOUT 代替设备应答. 队列满时 HostServer 直接以 E_OUT_OF_BUFFER 应答.
+ * 广播帧在本机执行的同时转发到所有下游链路
+ *
+ * @note 加密帧不在路由器解密, 各段链路须使用相同的加密套件; SET_LINK 只作用于单段链路, 不转发
+ * @note pump 与 HostServer::poll 在不同任务中运行时, 上游 HostServer 需要发送锁
+ */
+struct HostRouterBase
+{
+    ErrorCode        verify(Address self) const;
+    const RouteLink* find(Address target) const;
+    bool             push(Address target, Command cmd, Extra& extra, ErrorCode err);
+    bool             pump(HostBase& upstream);
+
+    /**
+     * @brief 获取因队列满而拒绝的帧数
+     *
+     * @return uint32_t 拒绝的帧数
+     */
+    uint32_t rejected() const
+    {
+        return _rejected;
+    }
+
+    /**
+     * @brief 获取下游应答超时的帧数
+     *
+     * @return uint32_t 超时的帧数
+     */
+    uint32_t timeouts() const
+    {
+        return _timeouts;
+    }
+
+  protected:
+    HostRouterBase(const RouteLink* routes, size_t size, uint8_t* queue, size_t capacity, Lock& lock)
+        : _routes(routes)
+        , _size(size)
+        , _queue(queue)
+        , _capacity(capacity)
+        , _lock(lock)
+    {
+    }
+
+    void write(const void* data, size_t size);
+    void read(void* data, size_t size);
+    bool pop(Address& target, Command& cmd, ErrorCode& err, Extra& extra);
+
+  protected:
+    // 路由表
+    const RouteLink* const _routes;
+    // 路由个数
+    const size_t           _size;
+    // 转发队列, 每帧为 目标地址, 命令, 错误码, 是否加密, 长度[, Tag], 附加参数
+    uint8_t* const         _queue;
+    // 转发队列容量
+    const size_t           _capacity;
+    // 队列锁
+    Lock&                  _lock;
+
+    // 队列读取位置
+    size_t                 _head     = 0;
+    // 队列已用长度
+    size_t                 _used     = 0;
+    // 拒绝的帧数
+    uint32_t               _rejected = 0;
+    // 超时的帧数
+    uint32_t               _timeouts = 0;
+    // 转发使用的附加参数缓冲区
+    Extra                  _extra;
+};
+
+/**
+ * @brief 路由器
+ *
+ * @tparam _links 路由个数
+ * @tparam _bytes 转发队列的字节数, 至少容纳一个最长的帧
+ */
+template <size_t _links, size_t _bytes = 2048>
+struct HostRouter : public HostRouterBase
+{
+    /**
+     * @param routes 路由表
+     * @param lock 队列锁, poll 与 pump 在不同任务中运行时需要
+     */
+    HostRouter(const std::array<RouteLink, _links>& routes, Lock& lock = no_lock)
+        : HostRouterBase(routes.data(), _links, _queue_buf, _bytes, lock)
+    {
+    }
+
+  protected:
+    uint8_t _queue_buf[_bytes];
+};
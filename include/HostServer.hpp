@@ -4,6 +4,11 @@
 #include <FixedQueue.hpp>
 #include <frozen/string.h>
 #include <HostBase.hpp>
+#include <HostRouter.hpp>
+#include <Latch.hpp>
+#include <LogBuffer.hpp>
+#include <LogFormat.hpp>
+#include <Scope.hpp>
 
 template <size_t _size>
 using PropertyMap = std::array<std::pair<frozen::string, PropertyBase*>, _size>;
@@ -99,21 +104,93 @@ struct PropertyHolder : public PropertyHolderBase
 
 struct HostServer : public HostBase
 {
-    HostServer(Address& address, const PropertyHolderBase& holder, SecretHolder& secret)
-        : HostBase(address, secret)
+    /**
+     * @param address 从机地址
+     * @param holder 属性值容器
+     * @param secret 密钥容器
+     * @param tx_lock 发送锁, 在其他任务中调用 log 时需要
+     * @param prop_lock 属性锁, 执行属性的读写方法时持有, 固件修改属性值时也应当持有
+     *
+     * @note 发送锁在发送整帧期间一直持有, 不应使用屏蔽中断的锁
+     * @note 属性锁只在复制属性值期间持有, 不跨越发送; 属性锁不是空锁时 GET_PROPERTY 不使用零拷贝发送
+     * @note 使用 SeqProperty/SeqMemory 的属性自带同步, 属性锁可以为空锁
+     */
+    HostServer(Address& address, const PropertyHolderBase& holder, SecretHolder& secret, Lock& tx_lock = no_lock,
+               Lock& prop_lock = no_lock)
+        : HostBase(address, secret, tx_lock)
         , _holder(holder)
+        , _prop_lock(prop_lock)
     {
     }
 
-    bool poll();
-    void log(const void* log, size_t size);
+    bool             poll();
+    void             log(const void* log, size_t size);
+    void             log(LogLevel level, const void* log, size_t size);
+    bool             flush_log();
+    void             set_log_buffer(LogBufferBase* buffer);
+    bool             flush_scope();
+    void             set_scope(ScopeBase* scope);
+    void             set_groups(const Address* groups, size_t size);
+    void             set_latch(LatchBase* latch);
+    void             set_uid(const UniqueId* uid);
+    ErrorCode        set_router(HostRouterBase* router);
+    virtual uint32_t features() const;
+
+    /**
+     * @brief 发送二进制日志, 只发送格式Id和打包的参数, 由 Client 根据格式表展开
+     *
+     * @param level 日志等级
+     * @param id 格式Id, 见 LogFormats
+     * @param args 格式参数, 类型要求见 LogArgs
+     */
+    template <typename... Args>
+    void log_fmt(LogLevel level, LogFormatId id, const Args&... args)
+    {
+        // 被过滤的日志不需要打包参数
+        if (_log && level < _log->config.level) return;
+        LogArgs packed(id);
+        (packed.add(args), ...);
+        log((LogLevel)((uint8_t)level | LOG_BINARY), packed.data(), packed.size());
+    }
 
   protected:
+    /**
+     * @brief 等待地址发现的应答时隙
+     *
+     * @note 固件应当延时 slot * width 微秒后返回; 默认不延时, 所有设备在同一时隙应答, 冲突只能依靠前缀二分解决
+     *
+     * @param slot 时隙
+     * @param width 时隙宽度, 微秒
+     */
+    virtual void  wait_slot(uint8_t slot, uint16_t width);
+    virtual bool  accepts(Address target) const override;
+    void          _reply(Command cmd, Extra& extra, bool encrypted, ErrorCode err);
+    bool          _forward(Command cmd, Extra& extra, ErrorCode err);
     PropertyBase* _acquire_and_verify(Command cmd, Extra& extra, bool encrypted);
+    ErrorCode     _configure_scope(uint16_t divider, Extra& extra);
 
   protected:
     // 附加参数缓冲区
     Extra                     _extra;
     // 属性值容器
     const PropertyHolderBase& _holder;
+    // 属性锁
+    Lock&                     _prop_lock;
+    // 日志缓冲区
+    LogBufferBase*            _log         = nullptr;
+    // 示波器模式的采样器
+    ScopeBase*                _scope       = nullptr;
+    // 锁存器
+    LatchBase*                _latch       = nullptr;
+    // 唯一Id
+    const UniqueId*           _uid         = nullptr;
+    // 已分配地址, 不再应答地址发现
+    bool                      _assigned    = false;
+    // 路由器
+    HostRouterBase*           _router      = nullptr;
+    // 组播地址
+    const Address*            _groups      = nullptr;
+    size_t                    _groups_size = 0;
+    // 当前请求是否为广播/组播, 不应答
+    bool                      _silent      = false;
 };
@@ -0,0 +1,92 @@
+#pragma once
+#include "PropertyBase.hpp"
+#include <string.h>
+
+/**
+ * @brief 锁存器, 收到 LATCH 命令时将一组属性的当前值同时保存到影子缓冲区
+ *
+ * @details
+ * 固件通过 add 配置要锁存的属性; Client 向广播/组播地址发送 LATCH, 各 Server 在同一时刻锁存,
+ * 之后再逐个读取锁存器属性, 不同设备的采样值来自同一时刻, 与读取的先后无关.
+ * 锁存器本身是只读属性, 属性值为 序号(uint16_t) + 各通道的锁存值, 序号由 LATCH 请求给出,
+ * Client 据此确认设备收到了同一次触发
+ *
+ * @note 锁存和读取都在 HostServer 的属性锁中进行, 各通道的值来自同一次加锁
+ */
+struct LatchBase : public PropertyAccess<Access::READ>
+{
+    void      clear();
+    ErrorCode add(const PropertyBase* prop);
+    void      trigger(uint16_t seq);
+
+    virtual ErrorCode get(Extra& extra, bool) const override;
+    virtual ErrorCode get_view(Extra&, bool, const uint8_t*& data, Size& size) const override;
+    virtual ErrorCode get_size(Extra& extra, bool) const override;
+
+    /**
+     * @brief 获取通道数
+     *
+     * @return size_t 通道数
+     */
+    size_t channels() const
+    {
+        return _count;
+    }
+
+    /**
+     * @brief 获取最近一次锁存的序号
+     *
+     * @return uint16_t 序号
+     */
+    uint16_t seq() const
+    {
+        uint16_t seq;
+        memcpy(&seq, _shadow, sizeof(seq));
+        return seq;
+    }
+
+  protected:
+    LatchBase(const PropertyBase** props, size_t channels, uint8_t* shadow, Size size)
+        : _props(props)
+        , _channels_max(channels)
+        , _shadow(shadow)
+        , _shadow_size(size)
+    {
+    }
+
+  protected:
+    // 锁存的属性
+    const PropertyBase** const _props;
+    // 最大通道数
+    const size_t               _channels_max;
+    // 影子缓冲区, 序号 + 锁存值
+    uint8_t* const             _shadow;
+    // 影子缓冲区锁存值部分的长度
+    const Size                 _shadow_size;
+
+    // 通道数
+    size_t                     _count = 0;
+    // 锁存值的总长度
+    Size                       _row   = 0;
+};
+
+/**
+ * @brief 锁存器
+ *
+ * @tparam _channels 最大通道数
+ * @tparam _size 锁存值的最大总长度, 不超过单帧附加参数的长度
+ */
+template <size_t _channels, Size _size = 64>
+struct Latch : public LatchBase
+{
+    static_assert(sizeof(uint16_t) + _size <= MEMORY_ACCESS_SIZE_MAX, "Latch is too large");
+
+    Latch()
+        : LatchBase(_prop_buf, _channels, _shadow_buf, _size)
+    {
+    }
+
+  protected:
+    const PropertyBase* _prop_buf[_channels];
+    uint8_t             _shadow_buf[sizeof(uint16_t) + _size] = {};
+};
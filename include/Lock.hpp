@@ -0,0 +1,136 @@
+#pragma once
+#include <stdint.h>
+
+/**
+ * @brief 锁接口
+ *
+ * @note 用于保护发送通路和属性访问, 由使用者根据运行环境选择实现
+ */
+struct Lock
+{
+    /**
+     * @brief 加锁, 阻塞直到获得锁
+     */
+    virtual void lock()   = 0;
+    /**
+     * @brief 解锁
+     */
+    virtual void unlock() = 0;
+
+    /**
+     * @brief 是否为空锁, 只有空锁可以在阻塞的发送期间持有
+     *
+     * @return true 空锁
+     */
+    virtual bool trivial() const
+    {
+        return false;
+    }
+};
+
+/**
+ * @brief 空锁, 适用于单线程环境
+ */
+struct NoLock : public Lock
+{
+    virtual void lock() override
+    {
+    }
+
+    virtual void unlock() override
+    {
+    }
+
+    virtual bool trivial() const override
+    {
+        return true;
+    }
+};
+
+/**
+ * @brief 互斥锁, 适用于 RTOS 任务间共享
+ *
+ * @tparam Mutex 提供 lock()/unlock() 的互斥量类型, 如 std::mutex 或 RTOS 互斥量的封装
+ */
+template <typename Mutex>
+struct MutexLock : public Lock
+{
+    virtual void lock() override
+    {
+        _mutex.lock();
+    }
+
+    virtual void unlock() override
+    {
+        _mutex.unlock();
+    }
+
+  protected:
+    Mutex _mutex;
+};
+
+/**
+ * @brief 屏蔽中断的锁, 适用于与中断共享
+ *
+ * @note 支持嵌套, 最外层解锁时才恢复中断状态
+ * @note 持有锁期间中断被屏蔽, 只应保护短小的临界区
+ */
+struct IrqLock : public Lock
+{
+    virtual void lock() override final
+    {
+        uint32_t state = disable_irq();
+        if (_depth++ == 0) _state = state;
+    }
+
+    virtual void unlock() override final
+    {
+        if (--_depth == 0) restore_irq(_state);
+    }
+
+  protected:
+    /**
+     * @brief 屏蔽中断
+     *
+     * @return uint32_t 屏蔽前的中断状态, 如 PRIMASK
+     */
+    virtual uint32_t disable_irq()               = 0;
+    /**
+     * @brief 恢复中断状态
+     *
+     * @param state disable_irq 返回的中断状态
+     */
+    virtual void     restore_irq(uint32_t state) = 0;
+
+  protected:
+    // 屏蔽前的中断状态
+    uint32_t _state = 0;
+    // 嵌套深度
+    uint32_t _depth = 0;
+};
+
+/**
+ * @brief 作用域锁, 构造时加锁, 析构时解锁
+ */
+struct LockGuard
+{
+    LockGuard(Lock& lock)
+        : _lock(lock)
+    {
+        _lock.lock();
+    }
+
+    ~LockGuard()
+    {
+        _lock.unlock();
+    }
+
+    LockGuard(const LockGuard&)            = delete;
+    LockGuard& operator=(const LockGuard&) = delete;
+
+  protected:
+    Lock& _lock;
+};
+
+// 默认使用的空锁
+inline NoLock no_lock;
@@ -0,0 +1,77 @@
+#pragma once
+#include "Lock.hpp"
+#include "Types.hpp"
+#include <cstddef>
+
+/**
+ * @brief 日志缓冲区
+ *
+ * @details
+ * 日志以 {LogLevel,长度(uint8_t),日志内容} 的格式存放在环形缓冲区中,
+ * 写入时只复制数据, 由 HostServer 在 poll 中打包为 LOG_BATCH 帧发送
+ *
+ * @note 单条日志最长 255 字节, 超出部分被截断
+ * @note 可以在中断中写入, 此时应当使用屏蔽中断的锁
+ * @note 配置可以通过 Property<LogConfig, Access::READ_WRITE> 暴露给 Client
+ */
+struct LogBufferBase
+{
+    // 单条日志的最大长度
+    static constexpr size_t RECORD_MAX = UINT8_MAX;
+
+    // 日志配置
+    LogConfig config;
+
+    bool     push(LogLevel level, const void* data, size_t size);
+    size_t   pop(uint8_t* buf, size_t capacity);
+    bool     empty() const;
+    uint32_t dropped() const;
+
+  protected:
+    LogBufferBase(uint8_t* data, size_t size, Lock& lock)
+        : _data(data)
+        , _capacity(size)
+        , _lock(lock)
+    {
+    }
+
+    void write(size_t pos, const void* data, size_t size);
+    void read(size_t pos, void* data, size_t size) const;
+    void drop_oldest();
+
+  protected:
+    // 存储区
+    uint8_t* const    _data;
+    // 存储区长度
+    const size_t      _capacity;
+    // 写入方之间的互斥锁
+    Lock&             _lock;
+    // 最早一条日志的位置
+    size_t            _head    = 0;
+    // 已使用的字节数
+    volatile size_t   _used    = 0;
+    // 丢弃的日志条数
+    volatile uint32_t _dropped = 0;
+};
+
+/**
+ * @brief 日志缓冲区
+ *
+ * @tparam _size 缓冲区长度
+ */
+template <size_t _size>
+struct LogBuffer : public LogBufferBase
+{
+    static_assert(_size >= 2 + RECORD_MAX, "LogBuffer is too small");
+
+    /**
+     * @param lock 写入方与 HostServer 之间的互斥锁
+     */
+    LogBuffer(Lock& lock = no_lock)
+        : LogBufferBase(_buf, _size, lock)
+    {
+    }
+
+  protected:
+    uint8_t _buf[_size];
+};
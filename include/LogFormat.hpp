@@ -0,0 +1,165 @@
+#pragma once
+#include "PropertyBase.hpp"
+#include <algorithm>
+#include <array>
+#include <frozen/string.h>
+#include <string.h>
+#include <type_traits>
+
+/**
+ * @brief 日志格式表, 下标即为 LogFormatId
+ *
+ * @tparam _size 格式个数
+ */
+template <size_t _size>
+using LogFormatTable = std::array<frozen::string, _size>;
+
+/**
+ * @brief 在编译期根据格式字符串查找 LogFormatId
+ *
+ * @param table 日志格式表
+ * @param format 格式字符串
+ * @return LogFormatId 格式Id, 找不到时编译失败
+ */
+template <size_t _size>
+consteval LogFormatId log_format_id(const LogFormatTable<_size>& table, const frozen::string format)
+{
+    for (size_t i = 0; i < _size; i++)
+        if (table[i] == format) return i;
+    throw "log format not found";
+}
+
+/**
+ * @brief 日志格式表属性, Client 连接时通过此属性获取格式表
+ *
+ * @details
+ * GET_PROPERTY: 附加参数为 LogFormatId, 返回格式字符串
+ * GET_SIZE: 返回格式个数
+ *
+ * @tparam _size 格式个数
+ */
+template <size_t _size>
+struct LogFormats : public PropertyAccess<Access::READ>
+{
+    static_assert(_size <= UINT16_MAX, "Too many log formats");
+
+    using Table = LogFormatTable<_size>;
+
+    LogFormats(const Table& table)
+        : _table(table)
+    {
+    }
+
+    virtual ErrorCode get(Extra& extra, bool) const override
+    {
+        LogFormatId id;
+        if (!extra.get(id)) return ErrorCode::E_INVALID_ARG;
+        if (id >= _size) return ErrorCode::E_OUT_OF_INDEX;
+
+        extra.reset();
+        if (!extra.add(_table[id].data(), _table[id].size())) return ErrorCode::E_OUT_OF_BUFFER;
+        return ErrorCode::S_OK;
+    }
+
+    virtual ErrorCode get_size(Extra& extra, bool) const override
+    {
+        extra.reset();
+        extra.add<Size>(_size);
+        return ErrorCode::S_OK;
+    }
+
+  protected:
+    const Table& _table;
+};
+
+/**
+ * @brief 二进制日志的参数打包器
+ *
+ * @details
+ * 参数按类型打包, 展开时不依赖转换说明中的长度修饰符, 与 printf 的默认参数提升一致:
+ * - 整数(含 char, bool): 长度(uint8_t, 1/2/4/8) + 本机类型的值, 对应 %d %i %u %x %X %o %c,
+ *   可带任意长度修饰符(%ld %zu %lld %hhd 等); 按转换说明符号扩展或零扩展, 如 %x 输出 int -1 为 ffffffff
+ * - 浮点数(float, double): 一律提升为 double, 8 字节, 对应 %f %e %g 及 %lf
+ * - 字符串: 长度(uint8_t) + 内容, 对应 %s
+ *
+ * @note 整数的长度由固件的类型决定, long/size_t 在 32 位固件上为 4 字节, 在 64 位上为 8 字节, Client 无需知道固件的 ABI
+ * @note 超出单条日志长度的参数及其后的参数被丢弃
+ */
+struct LogArgs
+{
+    // 单条日志的最大长度, 与 LogBuffer 保持一致
+    static constexpr size_t CAPACITY = UINT8_MAX;
+
+    LogArgs(LogFormatId id)
+    {
+        raw(&id, sizeof(id));
+    }
+
+    template <typename T>
+    void add(const T& value)
+    {
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            // 与 printf 的默认参数提升一致, %f 总是对应 double
+            double v = value;
+            raw(&v, sizeof(v));
+        }
+        else if constexpr (std::is_integral_v<T>)
+        {
+            static_assert(sizeof(T) <= sizeof(uint64_t), "Unsupported log argument width");
+            // 长度与值一起写入, 放不下时整个参数丢弃
+            uint8_t width = sizeof(T);
+            if (_full || _size + sizeof(width) + width > CAPACITY)
+            {
+                _full = true;
+                return;
+            }
+            raw(&width, sizeof(width));
+            raw(&value, width);
+        }
+        else if constexpr (std::is_convertible_v<const T&, const char*>)
+        {
+            // 缓冲区已满, 连长度也放不下
+            if (_full || _size >= CAPACITY)
+            {
+                _full = true;
+                return;
+            }
+            const char* str = value;
+            // 过长的字符串被截断
+            uint8_t     len = std::min<size_t>({strlen(str), UINT8_MAX, CAPACITY - _size - 1});
+            raw(&len, sizeof(len));
+            raw(str, len);
+        }
+        else
+            static_assert(sizeof(T) == 0, "Unsupported log argument type");
+    }
+
+    const uint8_t* data() const
+    {
+        return _buf.data();
+    }
+
+    size_t size() const
+    {
+        return _size;
+    }
+
+  protected:
+    void raw(const void* data, size_t size)
+    {
+        if (_full || _size + size > CAPACITY)
+        {
+            _full = true;
+            return;
+        }
+        memcpy(&_buf[_size], data, size);
+        _size += size;
+    }
+
+  protected:
+    std::array<uint8_t, CAPACITY> _buf;
+    size_t                        _size = 0;
+    // 参数已被丢弃, 不再打包后续参数
+    bool                          _full = false;
+};
@@ -1,5 +1,6 @@
 #pragma once
 #include "PropertyBase.hpp"
+#include <Crc.hpp>
 
 /**
  * @brief 内存区属性
@@ -46,6 +47,38 @@ struct Memory : public PropertyAccess<_access>
         return ErrorCode::S_OK;
     }
 
+    virtual ErrorCode get_view(Extra& extra, bool, const uint8_t*& data, Size& size) const override
+    {
+        MemoryAccess access;
+        // 检查访问参数是否正确
+        if (!extra.get(access)) return ErrorCode::E_INVALID_ARG;
+        // 检查是否超出内存区范围
+        if (sizeof(_value) < access.offset + access.size) return ErrorCode::E_OUT_OF_INDEX;
+        // 与经过缓冲区发送时的长度限制保持一致
+        if (access.size > extra.capacity()) return ErrorCode::E_OUT_OF_BUFFER;
+
+        data = (const uint8_t*)&_value + access.offset;
+        size = access.size;
+        return ErrorCode::S_OK;
+    }
+
+    virtual ErrorCode get_crc(Extra& extra, bool) const override
+    {
+        MemoryAccess access;
+        CrcType      type;
+        // 检查访问参数是否正确
+        if (!extra.get(access) || !extra.get(type)) return ErrorCode::E_INVALID_ARG;
+        if (type != CrcType::CRC32 && type != CrcType::CRC64) return ErrorCode::E_INVALID_ARG;
+        // 检查是否超出内存区范围
+        if (sizeof(_value) < access.offset + access.size) return ErrorCode::E_OUT_OF_INDEX;
+        extra.reset();
+
+        Crc crc(type);
+        crc.update((uint8_t*)&_value + access.offset, access.size);
+        crc.add(extra);
+        return ErrorCode::S_OK;
+    }
+
     virtual ErrorCode get_size(Extra& extra, bool) const override
     {
         extra.reset();
@@ -39,6 +39,12 @@ struct Property : public PropertyAccess<_access>
         return ErrorCode::S_OK;
     }
 
+    virtual Size sample(uint8_t* buf) const override
+    {
+        if (buf) memcpy(buf, &_value, sizeof(_value));
+        return sizeof(_value);
+    }
+
   protected:
     T& _value;
 };
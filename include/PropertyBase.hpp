@@ -20,6 +20,29 @@ struct PropertyBase
      * @return ErrorCode 错误码
      */
     virtual ErrorCode get(Extra& extra, bool privileged) const;
+    /**
+     * @brief 获取属性值所在的内存区域, 用于直接发送
+     *
+     * @note 不支持直接发送的属性返回 E_NO_IMPLEMENT, 且不读取附加参数
+     *
+     * @param extra [in]附加参数
+     * @param privileged [in]特权模式
+     * @param data [out]属性值的首地址
+     * @param size [out]属性值的字节长度
+     * @return ErrorCode 错误码
+     */
+    virtual ErrorCode get_view(Extra& extra, bool privileged, const uint8_t*& data, Size& size) const;
+    /**
+     * @brief 获取预先生成的完整应答帧(帧头, 帧头校验和, 属性值, 附加参数校验和), 用于 GET_PROPERTY
+     *
+     * @note 只用于未加密的请求和 CRC16 链路; 不支持或地址不一致时返回 E_NO_IMPLEMENT
+     *
+     * @param address [in]本机地址
+     * @param frame [out]应答帧的首地址
+     * @param size [out]应答帧的字节长度
+     * @return ErrorCode 错误码
+     */
+    virtual ErrorCode get_frame(Address address, const uint8_t*& frame, size_t& size) const;
     /**
      * @brief 获取属性长度
      *
@@ -28,6 +51,47 @@ struct PropertyBase
      * @return ErrorCode 错误码
      */
     virtual ErrorCode get_size(Extra& extra, bool privileged) const;
+    /**
+     * @brief 计算属性值的校验和
+     *
+     * @param extra [in/out]附加参数
+     * @param privileged [in]特权模式
+     * @return ErrorCode 错误码
+     */
+    virtual ErrorCode get_crc(Extra& extra, bool privileged) const;
+    /**
+     * @brief 提交缓存的写入
+     *
+     * @param extra [in/out]附加参数
+     * @param privileged [in]特权模式
+     * @return ErrorCode 错误码
+     */
+    virtual ErrorCode commit(Extra& extra, bool privileged);
+    /**
+     * @brief 开始事务
+     *
+     * @param extra [in/out]附加参数
+     * @param privileged [in]特权模式
+     * @return ErrorCode 错误码
+     */
+    virtual ErrorCode begin(Extra& extra, bool privileged);
+    /**
+     * @brief 放弃事务
+     *
+     * @param extra [in/out]附加参数
+     * @param privileged [in]特权模式
+     * @return ErrorCode 错误码
+     */
+    virtual ErrorCode abort(Extra& extra, bool privileged);
+    /**
+     * @brief 采样属性值, 用于示波器模式, 可能在中断中调用
+     *
+     * @note 不支持采样的属性返回 0
+     *
+     * @param buf [out]采样值, 为空时只返回长度
+     * @return Size 采样值的字节长度
+     */
+    virtual Size      sample(uint8_t* buf) const;
     /**
      * @brief 获取属性访问级别
      *
@@ -0,0 +1,36 @@
+#pragma once
+#include "Types.hpp"
+
+/**
+ * @brief 记录文件格式
+ *
+ * @details
+ * 记录文件由若干块依次组成, 只在文件末尾追加; 每块为 RecordChunk 加块数据, 块数据按 RECORD_ALIGN 对齐;
+ * 同一属性的采样点以列存储: 时间戳 uint64_t[count] 之后为采样值 [count * width]
+ *
+ * @note 文件末尾不完整的块在回放时被忽略
+ */
+
+// 块标识 "HSRC"
+constexpr uint32_t RECORD_MAGIC = 0x43525348;
+// 块数据的对齐长度
+constexpr size_t   RECORD_ALIGN = 8;
+
+enum class RecordKind : uint8_t
+{
+    SESSION = 0, // 新的记录会话, 之后的通道号重新分配
+    CHANNEL,     // 新通道, 块数据为属性名称
+    DATA,        // 采样数据, 块数据为时间戳列和采样值列
+};
+
+struct RecordChunk
+{
+    uint32_t   magic;   // 块标识
+    RecordKind kind;    // 块类型
+    uint8_t    width;   // 采样值长度
+    uint16_t   channel; // 通道号
+    uint32_t   count;   // 名称长度或采样点数
+    uint32_t   size;    // 块数据长度, 含对齐填充
+};
+
+static_assert(sizeof(RecordChunk) % RECORD_ALIGN == 0, "RecordChunk is not aligned");
@@ -0,0 +1,147 @@
+#pragma once
+#include <HostServer.hpp>
+#include <Record.hpp>
+#include <vector>
+
+/**
+ * @brief 记录文件的回放
+ *
+ * @details
+ * open 将 CRecorder 生成的记录文件映射到内存并建立块索引, 采样点直接从映射区读取, 不复制;
+ * 不同会话中名称相同的属性合并为一个通道
+ *
+ * @note 只用于 POSIX 平台的上位机, 实现在 src/posix 中, 由 HostServicePosix 库单独编译
+ */
+struct Replay
+{
+    ~Replay();
+
+    ErrorCode open(const char* path);
+    void      close();
+    size_t    find(const frozen::string name) const;
+    bool      at(size_t channel, size_t index, uint64_t& time, const uint8_t*& value) const;
+    size_t    lower_bound(size_t channel, uint64_t time) const;
+
+    /**
+     * @brief 获取通道数
+     *
+     * @return size_t 通道数
+     */
+    size_t channels() const
+    {
+        return _channels.size();
+    }
+
+    /**
+     * @brief 获取通道的属性名称
+     *
+     * @param channel 通道
+     * @return frozen::string 属性名称, 指向映射区
+     */
+    frozen::string name(size_t channel) const
+    {
+        return _channels[channel].name;
+    }
+
+    /**
+     * @brief 获取通道采样值的长度
+     *
+     * @param channel 通道
+     * @return Size 采样值长度
+     */
+    Size width(size_t channel) const
+    {
+        return _channels[channel].width;
+    }
+
+    /**
+     * @brief 获取通道的采样点数
+     *
+     * @param channel 通道
+     * @return size_t 采样点数
+     */
+    size_t size(size_t channel) const
+    {
+        return _channels[channel].count;
+    }
+
+  protected:
+    // 一个 DATA 块中的采样点
+    struct Segment
+    {
+        const uint64_t* times;  // 时间戳列
+        const uint8_t*  values; // 采样值列
+        size_t          first;  // 第一个采样点在通道中的序号
+        size_t          count;  // 采样点数
+    };
+
+    struct Channel
+    {
+        frozen::string       name;
+        Size                 width;
+        size_t               count;
+        std::vector<Segment> segments;
+    };
+
+    const Segment* segment(size_t channel, size_t index) const;
+
+  protected:
+    // 映射区
+    const uint8_t*       _map  = nullptr;
+    // 映射区长度
+    size_t               _size = 0;
+    std::vector<Channel> _channels;
+};
+
+/**
+ * @brief 回放的属性, 只读
+ *
+ * @details
+ * 每次读取返回通道的下一个采样点, 读到最后一个采样点后保持不变;
+ * 连续读取即可按记录的顺序全速回放
+ */
+struct ReplayProperty : public PropertyAccess<Access::READ>
+{
+    ReplayProperty(const Replay& replay, size_t channel)
+        : _replay(replay)
+        , _channel(channel)
+    {
+    }
+
+    virtual ErrorCode get(Extra& extra, bool) const override;
+    virtual ErrorCode get_size(Extra& extra, bool) const override;
+    virtual Size      sample(uint8_t* buf) const override;
+
+    void              seek(size_t index);
+    void              seek_time(uint64_t time);
+
+  protected:
+    const Replay&  _replay;
+    const size_t   _channel;
+    // 下一个采样点的序号
+    mutable size_t _cursor = 0;
+};
+
+/**
+ * @brief 回放的属性值容器
+ *
+ * @details
+ * 0号属性为 symbols, 第 i 个通道为 i + 1 号属性, 名称与记录时相同;
+ * 与任意 HostServer 实现组合即可代替硬件, 供上位机界面和分析工具连接
+ */
+struct ReplayHolder : public PropertyHolderBase
+{
+    ReplayHolder(const Replay& replay);
+
+    virtual PropertyBase*  get(PropertyId id) const override;
+    virtual frozen::string get_desc(PropertyId id) const override;
+    virtual size_t         size() const override;
+
+    void                   rewind();
+    void                   seek(uint64_t time);
+
+  protected:
+    const Replay&               _replay;
+    PropertySymbols             _symbols;
+    std::vector<ReplayProperty> _props;
+};
@@ -0,0 +1,222 @@
+#pragma once
+#include <HostServer.hpp>
+#include <SeqProperty.hpp>
+#include <tuple>
+#include <utility>
+
+/**
+ * @brief 属性描述
+ *
+ * @tparam T 属性值类型
+ * @tparam _access 访问级别
+ */
+template <PropertyVal T, Access _access = Access::READ>
+struct Field
+{
+    using type                    = T;
+    static constexpr Access access = _access;
+
+    // 属性名称
+    frozen::string name;
+
+    constexpr Field(const frozen::string name)
+        : name(name)
+    {
+    }
+};
+
+/**
+ * @brief 属性表描述, 由固件和上位机共同包含
+ *
+ * @details
+ * 0号属性为 symbols, 1号属性为 schema(描述的散列值, uint32_t 只读), 第 i 个描述的属性Id为 i + FIRST;
+ * Server 由 SchemaServer 生成 PropertyMap, Client 由 CSchema 生成带有属性Id的句柄, 不再按名称查找
+ *
+ * @code
+ * static constexpr Schema MySchema(Field<float, Access::READ_WRITE>("speed"), Field<uint32_t>("status"));
+ * @endcode
+ *
+ * @tparam Fields 属性描述
+ */
+template <typename... Fields>
+struct Schema
+{
+    // 第一个描述的属性Id
+    static constexpr PropertyId FIRST = 2;
+    // 描述的个数
+    static constexpr size_t     SIZE  = sizeof...(Fields);
+
+    static_assert(SIZE + FIRST <= UINT16_MAX, "Schema has too many fields");
+
+    std::tuple<Fields...> fields;
+
+    constexpr Schema(const Fields&... fields)
+        : fields(fields...)
+    {
+    }
+
+    /**
+     * @brief 编译期根据名称查找描述
+     *
+     * @note 名称不存在或重复时编译失败
+     *
+     * @param name 属性名称
+     * @return size_t 描述的序号
+     */
+    consteval size_t index(const frozen::string name) const
+    {
+        size_t found = SIZE;
+        size_t i     = 0;
+        std::apply(
+            [&](const Fields&... field)
+            {
+                ((field.name == name ? (found = found == SIZE ? i : throw "duplicate field name", i++) : i++), ...);
+            },
+            fields);
+        if (found == SIZE) throw "field name not found";
+        return found;
+    }
+
+    /**
+     * @brief 编译期获取属性Id
+     *
+     * @param name 属性名称
+     * @return PropertyId 属性Id
+     */
+    consteval PropertyId id(const frozen::string name) const
+    {
+        return index(name) + FIRST;
+    }
+
+    /**
+     * @brief 获取第 i 个描述的名称
+     *
+     * @param i 序号
+     * @return frozen::string 属性名称
+     */
+    constexpr frozen::string name(size_t i) const
+    {
+        frozen::string result = "";
+        size_t         k      = 0;
+        std::apply([&](const Fields&... field) { ((k++ == i ? (result = field.name, 0) : 0), ...); }, fields);
+        return result;
+    }
+
+    /**
+     * @brief 描述的散列值(FNV-1a), 包括名称, 类型长度和访问级别, Client 据此判断是否需要刷新Id表
+     *
+     * @return uint32_t 散列值
+     */
+    constexpr uint32_t hash() const
+    {
+        uint32_t value = 2166136261u;
+        auto     mix   = [&value](uint8_t byte) { value = (value ^ byte) * 16777619u; };
+        std::apply(
+            [&](const Fields&... field)
+            {
+                (
+                    [&]()
+                    {
+                        for (char c : field.name)
+                            mix(c);
+                        mix(0);
+                        mix(sizeof(typename Fields::type) & 0xFF);
+                        mix(sizeof(typename Fields::type) >> 8);
+                        mix((uint8_t)Fields::access);
+                    }(),
+                    ...);
+            },
+            fields);
+        return value;
+    }
+};
+
+/**
+ * @brief 属性模板的值类型和访问级别, 用于检查属性与描述是否一致
+ *
+ */
+template <typename P>
+struct SchemaTraits
+{
+    static constexpr bool known = false;
+};
+
+template <PropertyVal T, Access _access>
+struct SchemaTraits<Property<T, _access>>
+{
+    using type                    = T;
+    static constexpr bool   known  = true;
+    static constexpr Access access = _access;
+};
+
+template <PropertyVal T, Access _access>
+struct SchemaTraits<SeqProperty<T, _access>>
+{
+    using type                    = T;
+    static constexpr bool   known  = true;
+    static constexpr Access access = _access;
+};
+
+/**
+ * @brief 由属性表描述生成 Server 的属性值容器
+ *
+ * @note 属性按描述的顺序传入; 属性为 Property/SeqProperty 时, 值类型和访问级别必须与描述一致
+ *
+ * @tparam _schema 属性表描述
+ */
+template <const auto& _schema>
+struct SchemaServer
+{
+    using Desc                  = std::remove_cvref_t<decltype(_schema)>;
+    static constexpr size_t SIZE = Desc::SIZE + Desc::FIRST;
+
+    template <typename... Props>
+        requires(sizeof...(Props) == Desc::SIZE)
+    SchemaServer(Props&... props)
+        : _hash_value(_schema.hash())
+        , _hash(_hash_value)
+        , _map(make_map(std::index_sequence_for<Props...>(), props...))
+        , holder(_map, _symbols)
+    {
+        static_assert(check<Props...>(std::index_sequence_for<Props...>()), "Property does not match the schema");
+    }
+
+  protected:
+    template <typename... Props, size_t... I>
+    static consteval bool check(std::index_sequence<I...>)
+    {
+        return (match<Props, std::tuple_element_t<I, decltype(Desc::fields)>>() && ...);
+    }
+
+    template <typename P, typename F>
+    static consteval bool match()
+    {
+        using Traits = SchemaTraits<std::remove_cv_t<P>>;
+        if constexpr (Traits::known)
+            return std::is_same_v<typename Traits::type, typename F::type> && Traits::access == F::access;
+        else
+            return true;
+    }
+
+    template <size_t... I, typename... Props>
+    PropertyMap<SIZE> make_map(std::index_sequence<I...>, Props&... props)
+    {
+        return {
+            {
+             {"symbols", &_symbols},
+             {"schema", &_hash},
+             {std::get<I>(_schema.fields).name, (PropertyBase*)&props}...,
+             }
+        };
+    }
+
+  protected:
+    PropertySymbols                  _symbols;
+    uint32_t                         _hash_value;
+    Property<uint32_t, Access::READ> _hash;
+    PropertyMap<SIZE>                _map;
+
+  public:
+    // 属性值容器
+    PropertyHolder<SIZE> holder;
+};
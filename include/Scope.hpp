@@ -0,0 +1,136 @@
+#pragma once
+#include "Lock.hpp"
+#include "PropertyBase.hpp"
+
+/**
+ * @brief 示波器模式的采样器
+ *
+ * @details
+ * Client 通过 SET_SCOPE 配置要采样的属性和分频系数;
+ * 定时器中断中调用 tick, 每 divider 次采样一次所有通道, 采样值按采样点依次写入当前块;
+ * 当前块写满后与另一块交换, 由 HostServer 以 SCOPE_DATA 帧发送, 发送期间继续写入另一块
+ *
+ * @note 两块都未发送完时新的采样点被丢弃, 计入 overrun
+ * @note 块的前 2 字节为块序号, Client 据此检测丢失的块
+ */
+struct ScopeBase
+{
+    void      stop();
+    ErrorCode add(const PropertyBase* prop);
+    void      start(uint16_t divider);
+    void      tick();
+    bool      acquire(const uint8_t*& data, Size& size);
+    void      release();
+
+    /**
+     * @brief 获取通道数
+     *
+     * @return size_t 通道数
+     */
+    size_t channels() const
+    {
+        return _count;
+    }
+
+    /**
+     * @brief 获取通道采样值的长度
+     *
+     * @param channel 通道
+     * @return Size 采样值长度
+     */
+    Size width(size_t channel) const
+    {
+        return _widths[channel];
+    }
+
+    /**
+     * @brief 获取丢弃的采样点数
+     *
+     * @return uint32_t 丢弃的采样点数
+     */
+    uint32_t overrun() const
+    {
+        return _overrun;
+    }
+
+  protected:
+    ScopeBase(const PropertyBase** props, uint8_t* widths, size_t channels, uint8_t* blocks, Size block, Lock& lock)
+        : _props(props)
+        , _widths(widths)
+        , _channels_max(channels)
+        , _blocks(blocks)
+        , _block_size(block)
+        , _lock(lock)
+    {
+    }
+
+    uint8_t* block(uint8_t index)
+    {
+        return &_blocks[index * (sizeof(uint16_t) + _block_size)];
+    }
+
+    bool swap();
+
+  protected:
+    // 采样的属性
+    const PropertyBase** const _props;
+    // 各通道采样值的长度
+    uint8_t* const             _widths;
+    // 最大通道数
+    const size_t               _channels_max;
+    // 双缓冲区, 每块为 块序号 + 采样数据
+    uint8_t* const             _blocks;
+    // 每块采样数据的长度
+    const Size                 _block_size;
+    // 采样与配置/发送之间的互斥锁
+    Lock&                      _lock;
+
+    // 通道数
+    size_t                     _count    = 0;
+    // 每个采样点的长度
+    Size                       _row      = 0;
+    // 分频系数
+    uint16_t                   _divider  = 1;
+    // 分频计数
+    uint16_t                   _phase    = 0;
+    // 是否正在采样
+    volatile bool              _running  = false;
+    // 正在写入的块
+    uint8_t                    _active   = 0;
+    // 正在写入的块已写入的长度
+    Size                       _fill     = 0;
+    // 是否有待发送的块, 待发送的块总是另一块
+    volatile bool              _pending  = false;
+    // 待发送块的长度
+    Size                       _ready    = 0;
+    // 块序号
+    uint16_t                   _seq      = 0;
+    // 丢弃的采样点数
+    volatile uint32_t          _overrun  = 0;
+};
+
+/**
+ * @brief 示波器模式的采样器
+ *
+ * @tparam _channels 最大通道数
+ * @tparam _block 每块采样数据的长度, 不超过单帧附加参数的长度
+ */
+template <size_t _channels, Size _block = 512>
+struct Scope : public ScopeBase
+{
+    static_assert(_block <= MEMORY_ACCESS_SIZE_MAX, "Scope block is too large");
+    static_assert(_block >= _channels * SCOPE_WIDTH_MAX, "Scope block is too small");
+
+    /**
+     * @param lock 定时器中断与 HostServer 之间的互斥锁, 通常为屏蔽中断的锁
+     */
+    Scope(Lock& lock = no_lock)
+        : ScopeBase(_prop_buf, _width_buf, _channels, _block_buf, _block, lock)
+    {
+    }
+
+  protected:
+    const PropertyBase* _prop_buf[_channels];
+    uint8_t             _width_buf[_channels];
+    uint8_t             _block_buf[2 * (sizeof(uint16_t) + _block)];
+};
@@ -0,0 +1,69 @@
+#pragma once
+#include "Lock.hpp"
+#include <atomic>
+
+/**
+ * @brief 顺序锁
+ *
+ * @details
+ * 写入方持有写锁期间序号为奇数, 读取方复制数据前后比较序号, 不一致则重试;
+ * 读取方从不阻塞写入方, 适合控制环路频繁写入, 主机偶尔读取大块数据的场景
+ *
+ * @note 写入方之间的互斥由构造时传入的锁保证, 只有一个写入方时可以使用空锁
+ * @note 作为 Lock 使用时, lock/unlock 即为写锁, 可以配合 LockGuard 使用
+ */
+struct SeqLock : public Lock
+{
+    // 读取失败前的最大重试次数
+    static constexpr uint32_t RETRY = 8;
+
+    /**
+     * @param writer 写入方之间的互斥锁
+     */
+    SeqLock(Lock& writer = no_lock)
+        : _writer(writer)
+    {
+    }
+
+    virtual void lock() override
+    {
+        _writer.lock();
+        _seq.store(_seq.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    virtual void unlock() override
+    {
+        _seq.store(_seq.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        _writer.unlock();
+    }
+
+    /**
+     * @brief 读取数据
+     *
+     * @note 写入方可能在读取期间被读取方抢占, 因此不会自旋等待, 而是在重试次数用尽后返回失败
+     *
+     * @param copy 复制数据的方法, 可能被调用多次
+     * @return true 读取到一致的数据
+     * @return false 重试次数用尽
+     */
+    template <typename F>
+    bool read(F&& copy) const
+    {
+        for (uint32_t i = 0; i < RETRY; i++)
+        {
+            uint32_t seq = _seq.load(std::memory_order_acquire);
+            if (seq & 1) continue;
+            copy();
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (_seq.load(std::memory_order_relaxed) == seq) return true;
+        }
+        return false;
+    }
+
+  protected:
+    // 写入方之间的互斥锁
+    Lock&                 _writer;
+    // 序号, 为奇数时正在写入
+    std::atomic<uint32_t> _seq = 0;
+};
@@ -0,0 +1,85 @@
+#pragma once
+#include "Memory.hpp"
+#include "SeqLock.hpp"
+
+/**
+ * @brief 使用顺序锁保护的内存区属性
+ *
+ * @details
+ * 读取时先复制到附加参数缓冲区, 复制期间被写入则重试, 读取大块数据不会阻塞控制环路;
+ * 因此不支持直接从属性值所在的内存发送
+ *
+ * @note 固件修改属性值时应当持有写锁: LockGuard guard(mem.seq);
+ * @note 写入频率过高导致重试次数用尽时, 读取返回 E_TIMEOUT
+ *
+ * @tparam T 标准布局类型
+ * @tparam access 访问级别
+ */
+template <PropertyVal T, Access _access = Access::READ>
+struct SeqMemory : public Memory<T, _access>
+{
+    using parent = Memory<T, _access>;
+
+    /**
+     * @param value 属性值
+     * @param writer 写入方之间的互斥锁
+     */
+    SeqMemory(T& value, Lock& writer = no_lock)
+        : parent(value)
+        , seq(writer)
+    {
+    }
+
+    virtual ErrorCode set(Extra& extra, bool privileged) override
+    {
+        LockGuard guard(seq);
+        return parent::set(extra, privileged);
+    }
+
+    virtual ErrorCode get(Extra& extra, bool) const override
+    {
+        MemoryAccess access;
+        // 检查访问参数是否正确
+        if (!extra.get(access)) return ErrorCode::E_INVALID_ARG;
+        // 检查是否超出内存区范围
+        if (sizeof(this->_value) < access.offset + access.size) return ErrorCode::E_OUT_OF_INDEX;
+        extra.reset();
+        if (access.size > extra.spare()) return ErrorCode::E_OUT_OF_BUFFER;
+
+        const uint8_t* src = (const uint8_t*)&this->_value + access.offset;
+        if (!seq.read([&] { memcpy(extra.curr(), src, access.size); })) return ErrorCode::E_TIMEOUT;
+        extra.seek(access.size);
+        return ErrorCode::S_OK;
+    }
+
+    virtual ErrorCode get_view(Extra&, bool, const uint8_t*&, Size&) const override
+    {
+        // 发送期间无法检测写入
+        return ErrorCode::E_NO_IMPLEMENT;
+    }
+
+    virtual ErrorCode get_crc(Extra& extra, bool) const override
+    {
+        MemoryAccess access;
+        CrcType      type;
+        // 检查访问参数是否正确
+        if (!extra.get(access) || !extra.get(type)) return ErrorCode::E_INVALID_ARG;
+        if (type != CrcType::CRC32 && type != CrcType::CRC64) return ErrorCode::E_INVALID_ARG;
+        // 检查是否超出内存区范围
+        if (sizeof(this->_value) < access.offset + access.size) return ErrorCode::E_OUT_OF_INDEX;
+        extra.reset();
+
+        const uint8_t* src = (const uint8_t*)&this->_value + access.offset;
+        Crc            crc(type);
+        if (!seq.read([&] {
+                crc = Crc(type);
+                crc.update(src, access.size);
+            }))
+            return ErrorCode::E_TIMEOUT;
+        crc.add(extra);
+        return ErrorCode::S_OK;
+    }
+
+    // 顺序锁
+    mutable SeqLock seq;
+};
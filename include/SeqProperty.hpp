@@ -0,0 +1,51 @@
+#pragma once
+#include "Property.hpp"
+#include "SeqLock.hpp"
+
+/**
+ * @brief 使用顺序锁保护的属性值
+ *
+ * @note 固件修改属性值时应当持有写锁: LockGuard guard(prop.seq);
+ *
+ * @tparam T 类型参数
+ * @tparam access 访问级别
+ */
+template <PropertyVal T, Access _access = Access::READ>
+struct SeqProperty : public Property<T, _access>
+{
+    using parent = Property<T, _access>;
+
+    /**
+     * @param value 属性值
+     * @param writer 写入方之间的互斥锁
+     */
+    SeqProperty(T& value, Lock& writer = no_lock)
+        : parent(value)
+        , seq(writer)
+    {
+    }
+
+    virtual ErrorCode get(Extra& extra, bool) const override
+    {
+        T value;
+        if (!seq.read([&] { memcpy(&value, &this->_value, sizeof(value)); })) return ErrorCode::E_TIMEOUT;
+        extra.reset();
+        if (!extra.add(value)) return ErrorCode::E_OUT_OF_BUFFER;
+        return ErrorCode::S_OK;
+    }
+
+    virtual ErrorCode set(Extra& extra, bool) override
+    {
+        T value;
+        if (!extra.get(value)) return ErrorCode::E_INVALID_ARG;
+        {
+            LockGuard guard(seq);
+            this->_value = value;
+        }
+        extra.reset();
+        return ErrorCode::S_OK;
+    }
+
+    // 顺序锁
+    mutable SeqLock seq;
+};
@@ -35,6 +35,9 @@ enum class LogLevel : uint8_t
     ERROR
 };
 
+// LogLevel 的最高位作为二进制日志标记, 日志内容为 {LogFormatId,打包的参数}
+constexpr uint8_t LOG_BINARY = 0x80;
+
 enum class RangeMode : uint8_t
 {
     Hard,  // 超出范围的赋值 不会 生效
@@ -48,6 +51,24 @@ enum class RangeAccess : uint8_t
     Absolute   // 范围的绝对最大值
 };
 
+enum class LogOverflow : uint8_t
+{
+    DROP_NEW = 0, // 日志缓冲区满时丢弃新的日志
+    DROP_OLD      // 日志缓冲区满时丢弃最早的日志
+};
+
+enum class CrcType : uint8_t
+{
+    CRC32 = 0, // CRC-32/ISO-HDLC
+    CRC64      // CRC-64/ECMA-182
+};
+
+enum class ChecksumType : uint8_t
+{
+    CRC16 = 0, // CRC16-CCITT-False, 默认值
+    CRC32C     // CRC-32C(Castagnoli)
+};
+
 enum class Access : uint8_t
 {
     /**
@@ -110,45 +131,268 @@ enum class Command : uint8_t
      *
      * 请求: CMD,LogLevel,日志内容
      * 应答: 无
+     *
+     * @note LogLevel 带有 LOG_BINARY 标记时, 日志内容为 LogFormatId 和打包的参数
+     */
+    LOG,
+    /**
+     * @brief 获取 Server 的通信能力
+     *
+     * 请求: CMD
+     * 应答:
+     * CMD,S_OK,Capability
+     */
+    GET_CAPABILITY,
+    /**
+     * @brief 提交属性值的缓存写入/事务
+     *
+     * 请求: CMD,属性Id[,CRC32]
+     * 应答:
+     * CMD,S_OK
+     */
+    COMMIT,
+    /**
+     * @brief 开始事务, 事务中的写入在提交前不会生效
+     *
+     * 请求: CMD,属性Id
+     * 应答:
+     * CMD,S_OK
+     */
+    BEGIN,
+    /**
+     * @brief 放弃事务
+     *
+     * 请求: CMD,属性Id
+     * 应答:
+     * CMD,S_OK
+     */
+    ABORT,
+    /**
+     * @brief 计算内存区的校验和
+     *
+     * 请求: CMD,属性Id,MemoryAccess,CrcType
+     * 应答:
+     * CMD,S_OK,校验和
+     */
+    GET_CRC,
+    /**
+     * @brief 设置链路参数, 应答发送后才生效
+     *
+     * 请求: CMD[,LinkOption,参数值]
+     * 应答:
+     * CMD,S_OK
+     *
+     * @note 不带附加参数时将链路参数恢复为默认值
+     * @note 链路参数由整条总线共用, 多点总线上应发往广播地址, 所有设备同时切换且不应答
+     */
+    SET_LINK,
+    /**
+     * @brief Server 批量日志, 一帧包含多条日志
+     *
+     * 请求: CMD,{LogLevel,长度(uint8_t),日志内容}...
+     * 应答: 无
+     */
+    LOG_BATCH,
+    /**
+     * @brief 配置示波器模式, 不带属性Id时停止采样
+     *
+     * 请求: CMD,分频系数(uint16_t)[,属性Id...]
+     * 应答:
+     * CMD,S_OK[,采样值长度(uint8_t)...]
+     */
+    SET_SCOPE,
+    /**
+     * @brief Server 发送的采样数据块, 按采样点依次排列各通道的采样值
+     *
+     * 请求: CMD,块序号(uint16_t),{采样值...}...
+     * 应答: 无
      */
-    LOG
+    SCOPE_DATA,
+    /**
+     * @brief 锁存属性值, 通常发往广播/组播地址, 之后读取锁存器属性获得锁存值
+     *
+     * 请求: CMD,序号(uint16_t)
+     * 应答:
+     * CMD,S_OK
+     */
+    LATCH,
+    /**
+     * @brief 地址发现, 发往广播地址, 唯一Id匹配前缀且未分配地址的 Server 在各自的时隙应答
+     *
+     * 请求: CMD[,DiscoverRequest]
+     * 应答:
+     * CMD,S_OK,UniqueId
+     *
+     * @note 不带附加参数时所有 Server 恢复为未分配状态, 不应答
+     */
+    DISCOVER,
+    /**
+     * @brief 按唯一Id分配地址, Server 以新地址应答
+     *
+     * 请求: CMD,UniqueId,地址
+     * 应答:
+     * CMD,S_OK,UniqueId
+     */
+    ASSIGN
+};
+
+/**
+ * @brief Server 支持的功能
+ *
+ */
+enum class Feature : uint32_t
+{
+    ENCRYPT     = 1 << 0, // 加密通信
+    TRANSACTION = 1 << 1, // 事务写入
+    CRC         = 1 << 2, // 内存区校验和
+    CRC32C      = 1 << 3, // CRC-32C 附加参数校验和
+    SCOPE       = 1 << 4, // 示波器模式
+    CIPHER      = 1 << 5, // 加密套件协商, 见 CipherSuite
+    LATCH       = 1 << 6, // 锁存属性值
+    DISCOVER    = 1 << 7, // 地址发现与分配
+    ROUTER      = 1 << 8, // 路由转发
+};
+
+/**
+ * @brief 链路参数
+ *
+ */
+enum class LinkOption : uint8_t
+{
+    CHECKSUM = 0, // 附加参数校验和类型, 见 ChecksumType
+    CIPHER,       // 加密套件, 见 CipherSuite::encode
+};
+
+enum class CipherMode : uint8_t
+{
+    CCM = 0, // AES-CCM, 默认值
+    GCM      // AES-GCM, 每个分组只需一次 AES 运算; 请求与应答的随机数区分之前 SET_LINK 不接受
+};
+
+enum class CipherKey : uint8_t
+{
+    AES256 = 0, // 256 位密钥, 默认值
+    AES128      // 128 位密钥, 使用密钥的前 16 字节
+};
+
+enum class CipherTag : uint8_t
+{
+    TAG16 = 0, // 16 字节 Tag, 默认值
+    TAG12,     // 12 字节 Tag
+    TAG8       // 8 字节 Tag
 };
 
 /**
  * @brief 校验和
- * @details 算法: CRC16-CCITT-False
+ * @details 算法: CRC16-CCITT-False, 附加参数的校验和可通过 SET_LINK 切换为 CRC-32C
  */
-using Checksum   = uint16_t;
+using Checksum    = uint16_t;
 /**
  * @brief 属性值Id
  *
  */
-using PropertyId = uint16_t;
+using PropertyId  = uint16_t;
 /**
  * @brief 地址
  *
  */
-using Address    = uint8_t;
+using Address     = uint8_t;
+/**
+ * @brief 广播地址, 所有 Server 静默执行, 不应答
+ *
+ */
+constexpr Address ADDRESS_BROADCAST = 0xFF;
 /**
  * @brief 数据长度
  *
  */
-using Size       = uint16_t;
+using Size        = uint16_t;
 /**
- * @brief CEC-MAC
+ * @brief 日志格式Id
  *
  */
-using TagType    = std::array<uint8_t, 16>;
+using LogFormatId = uint16_t;
+/**
+ * @brief CBC-MAC/GMAC, 按 CipherSuite 只发送末尾的 tag_size 字节
+ *
+ */
+using TagType     = std::array<uint8_t, 16>;
 /**
  * @brief 随机数
  *
  */
-using NonceType  = std::array<uint8_t, 12>;
+using NonceType   = std::array<uint8_t, 12>;
 /**
  * @brief 密钥
  *
  */
-using KeyType    = std::array<uint8_t, 256 / 8>;
+using KeyType     = std::array<uint8_t, 256 / 8>;
+/**
+ * @brief 设备唯一Id, 通常为 MCU 的 96 位唯一Id
+ *
+ */
+using UniqueId    = std::array<uint8_t, 12>;
+
+/**
+ * @brief 加密套件, 通过 SET_LINK 协商
+ *
+ * @details
+ * 参数值按位编码: bit0 为 CipherMode, bit1 为 CipherKey, bit2~3 为 CipherTag, 其余位为 0;
+ * 编码为 0 时即默认的 AES-256-CCM, 16 字节 Tag
+ */
+struct CipherSuite
+{
+    CipherMode mode = CipherMode::CCM;
+    CipherKey  key  = CipherKey::AES256;
+    CipherTag  tag  = CipherTag::TAG16;
+
+    /**
+     * @brief 编码为 SET_LINK 的参数值
+     *
+     * @return uint8_t 参数值
+     */
+    constexpr uint8_t encode() const
+    {
+        return (uint8_t)mode | (uint8_t)key << 1 | (uint8_t)tag << 2;
+    }
+
+    /**
+     * @brief 从 SET_LINK 的参数值解码
+     *
+     * @param value 参数值
+     * @param suite [out]加密套件
+     * @return true 参数值有效
+     * @return false 参数值无效
+     */
+    static constexpr bool decode(uint8_t value, CipherSuite& suite)
+    {
+        if ((value >> 4) != 0 || ((value >> 2) & 0x03) > (uint8_t)CipherTag::TAG8) return false;
+        suite.mode = (CipherMode)(value & 0x01);
+        suite.key  = (CipherKey)((value >> 1) & 0x01);
+        suite.tag  = (CipherTag)((value >> 2) & 0x03);
+        return true;
+    }
+
+    /**
+     * @brief Tag 长度
+     *
+     * @return uint8_t Tag 的字节数
+     */
+    constexpr uint8_t tag_size() const
+    {
+        return 16 - 4 * (uint8_t)tag;
+    }
+
+    /**
+     * @brief 密钥长度
+     *
+     * @return uint8_t 密钥的字节数
+     */
+    constexpr uint8_t key_size() const
+    {
+        return key == CipherKey::AES128 ? 16 : 32;
+    }
+};
 
 /**
  * @brief 属性值类型
@@ -178,6 +422,8 @@ struct Header
     ErrorCode error;   // 错误码
 } __packed;
 
+static_assert(sizeof(Header) == 5, "Header must be packed");
+
 /**
  * @brief 内存属性的访问参数
  *
@@ -193,6 +439,149 @@ struct MemoryAccess
     }
 } __packed;
 
+static_assert(sizeof(MemoryAccess) == 4, "MemoryAccess must be packed");
+
+/**
+ * @brief Server 的通信能力
+ *
+ */
+struct Capability
+{
+    Size     capacity; // 附加参数缓冲区容量
+    Size     memory;   // 内存属性单次访问的最大长度
+    uint32_t features; // 支持的功能, 见 Feature
+
+    /**
+     * @brief 检查是否支持某项功能
+     *
+     * @param feature 功能
+     * @return true 支持
+     * @return false 不支持
+     */
+    bool has(Feature feature) const
+    {
+        return features & (uint32_t)feature;
+    }
+} __packed;
+
+static_assert(sizeof(Capability) == 8, "Capability must be packed");
+
+/**
+ * @brief 地址发现请求
+ *
+ * @details
+ * 唯一Id按位编号, 第 i 位为 uid[i / 8] 的第 7 - i % 8 位(高位在前);
+ * 前 bits 位与 prefix 相同的设备匹配, bits 为 0 时所有设备匹配
+ */
+struct DiscoverRequest
+{
+    uint16_t seed;   // 随机种子, 每次请求不同, 决定各设备的应答时隙
+    uint8_t  slots;  // 时隙数
+    uint16_t width;  // 时隙宽度, 微秒
+    uint8_t  bits;   // 前缀位数
+    UniqueId prefix; // 唯一Id前缀
+
+    /**
+     * @brief 唯一Id是否匹配前缀
+     *
+     * @param uid 唯一Id
+     * @return true 匹配
+     * @return false 不匹配
+     */
+    bool match(const UniqueId& uid) const
+    {
+        if (bits > uid.size() * 8) return false;
+        for (uint8_t i = 0; i < bits; i++)
+        {
+            uint8_t mask = 0x80 >> (i % 8);
+            if ((uid[i / 8] ^ prefix[i / 8]) & mask) return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief 计算应答时隙, 由种子和唯一Id散列(FNV-1a)得到, 设备无需随机数外设
+     *
+     * @param uid 唯一Id
+     * @return uint8_t 时隙, 小于 slots
+     */
+    uint8_t slot(const UniqueId& uid) const
+    {
+        if (slots <= 1) return 0;
+        uint32_t value = 2166136261u;
+        value          = (value ^ (seed & 0xFF)) * 16777619u;
+        value          = (value ^ (seed >> 8)) * 16777619u;
+        for (uint8_t byte : uid)
+            value = (value ^ byte) * 16777619u;
+        return value % slots;
+    }
+} __packed;
+
+static_assert(sizeof(DiscoverRequest) == 6 + sizeof(UniqueId), "DiscoverRequest must be packed");
+
+/**
+ * @brief 路由, 将上游的一段地址映射到下游总线
+ *
+ * @details
+ * 上游地址 first + i 对应下游地址 base + i, i < size; Client 与路由器使用同一张路由表,
+ * 多级路由时由内向外依次转换, 如 routes_1[p].upstream(routes_2[q].upstream(address))
+ */
+struct Route
+{
+    Address first; // 上游地址范围的起始
+    Address size;  // 地址个数
+    Address base;  // 下游地址的起始
+
+    /**
+     * @brief 上游地址是否属于此路由
+     *
+     * @param address 上游地址
+     * @return true 属于
+     * @return false 不属于
+     */
+    constexpr bool contains(Address address) const
+    {
+        return address >= first && address - first < size;
+    }
+
+    /**
+     * @brief 上游地址转换为下游地址
+     *
+     * @param address 上游地址
+     * @return Address 下游地址
+     */
+    constexpr Address downstream(Address address) const
+    {
+        return base + (address - first);
+    }
+
+    /**
+     * @brief 下游地址转换为上游地址, 即 Client 使用的地址
+     *
+     * @param address 下游地址
+     * @return Address 上游地址
+     */
+    constexpr Address upstream(Address address) const
+    {
+        return first + (address - base);
+    }
+};
+
+/**
+ * @brief 日志缓冲区配置
+ *
+ */
+struct LogConfig
+{
+    LogLevel    level    = LogLevel::VERBOSE;     // 低于此等级的日志被丢弃
+    LogOverflow overflow = LogOverflow::DROP_NEW; // 缓冲区满时的处理方式
+} __packed;
+
+static_assert(sizeof(LogConfig) == 2, "LogConfig must be packed");
+
+// 示波器模式单个通道采样值的最大长度
+constexpr uint8_t SCOPE_WIDTH_MAX = 8;
+
 /**
  * @brief 范围属性
  *
@@ -220,4 +609,6 @@ struct RangeVal
     {
         return this->min == range.min && this->max == range.max;
     }
-} __packed;
\ No newline at end of file
+} __packed;
+
+static_assert(sizeof(RangeVal<uint8_t>) == 2 && sizeof(RangeVal<double>) == 16, "RangeVal must be packed");
\ No newline at end of file
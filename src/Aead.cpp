@@ -0,0 +1,404 @@
+#include "Aead.hpp"
+#include <string.h>
+#include <uaes.h>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+  #define AEAD_X86 1
+  #include <immintrin.h>
+#else
+  #define AEAD_X86 0
+#endif
+
+void aead_encrypt_sw(const CipherSuite& suite, const KeyType& key, const NonceType& nonce, uint8_t* data, size_t size,
+                     uint8_t* tag)
+{
+    if (suite.mode == CipherMode::GCM)
+        UAES_GCM_SimpleEncrypt(key.data(), suite.key_size(), nonce.data(), nonce.size(), NULL, 0, data, data, size, tag,
+                               suite.tag_size());
+    else
+        UAES_CCM_SimpleEncrypt(key.data(), suite.key_size(), nonce.data(), nonce.size(), NULL, 0, data, data, size, tag,
+                               suite.tag_size());
+}
+
+bool aead_decrypt_sw(const CipherSuite& suite, const KeyType& key, const NonceType& nonce, uint8_t* data, size_t size,
+                     const uint8_t* tag)
+{
+    if (suite.mode == CipherMode::GCM)
+        return UAES_GCM_SimpleDecrypt(key.data(), suite.key_size(), nonce.data(), nonce.size(), NULL, 0, data, data,
+                                      size, tag, suite.tag_size());
+    return UAES_CCM_SimpleDecrypt(key.data(), suite.key_size(), nonce.data(), nonce.size(), NULL, 0, data, data, size,
+                                  tag, suite.tag_size());
+}
+
+#if AEAD_X86
+  #define AEAD_TARGET __attribute__((target("aes,pclmul,sse4.1")))
+
+namespace
+{
+struct AesKey
+{
+    __m128i rk[15];
+    size_t  rounds;
+};
+
+AEAD_TARGET inline __m128i key_mix(__m128i key, __m128i gen)
+{
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    return _mm_xor_si128(key, gen);
+}
+
+// aeskeygenassist 的轮常数必须是立即数
+  #define EXPAND128(i, rcon)                                                                                           \
+      k.rk[i] = key_mix(k.rk[i - 1], _mm_shuffle_epi32(_mm_aeskeygenassist_si128(k.rk[i - 1], rcon), 0xFF))
+  #define EXPAND256(i, rcon)                                                                                           \
+      k.rk[i]     = key_mix(k.rk[i - 2], _mm_shuffle_epi32(_mm_aeskeygenassist_si128(k.rk[i - 1], rcon), 0xFF));       \
+      k.rk[i + 1] = key_mix(k.rk[i - 1], _mm_shuffle_epi32(_mm_aeskeygenassist_si128(k.rk[i], 0x00), 0xAA))
+
+AEAD_TARGET void expand_key(const CipherSuite& suite, const KeyType& key, AesKey& k)
+{
+    k.rk[0] = _mm_loadu_si128((const __m128i*)key.data());
+    if (suite.key == CipherKey::AES128)
+    {
+        k.rounds = 10;
+        EXPAND128(1, 0x01);
+        EXPAND128(2, 0x02);
+        EXPAND128(3, 0x04);
+        EXPAND128(4, 0x08);
+        EXPAND128(5, 0x10);
+        EXPAND128(6, 0x20);
+        EXPAND128(7, 0x40);
+        EXPAND128(8, 0x80);
+        EXPAND128(9, 0x1B);
+        EXPAND128(10, 0x36);
+    }
+    else
+    {
+        k.rounds = 14;
+        k.rk[1]  = _mm_loadu_si128((const __m128i*)(key.data() + 16));
+        EXPAND256(2, 0x01);
+        EXPAND256(4, 0x02);
+        EXPAND256(6, 0x04);
+        EXPAND256(8, 0x08);
+        EXPAND256(10, 0x10);
+        EXPAND256(12, 0x20);
+        k.rk[14] = key_mix(k.rk[12], _mm_shuffle_epi32(_mm_aeskeygenassist_si128(k.rk[13], 0x40), 0xFF));
+    }
+}
+
+AEAD_TARGET inline __m128i aes(const AesKey& k, __m128i block)
+{
+    block = _mm_xor_si128(block, k.rk[0]);
+    for (size_t r = 1; r < k.rounds; r++)
+        block = _mm_aesenc_si128(block, k.rk[r]);
+    return _mm_aesenclast_si128(block, k.rk[k.rounds]);
+}
+
+// 交错执行两个独立的分组, 隐藏 aesenc 的延迟
+AEAD_TARGET inline void aes2(const AesKey& k, __m128i& a, __m128i& b)
+{
+    a = _mm_xor_si128(a, k.rk[0]);
+    b = _mm_xor_si128(b, k.rk[0]);
+    for (size_t r = 1; r < k.rounds; r++)
+    {
+        a = _mm_aesenc_si128(a, k.rk[r]);
+        b = _mm_aesenc_si128(b, k.rk[r]);
+    }
+    a = _mm_aesenclast_si128(a, k.rk[k.rounds]);
+    b = _mm_aesenclast_si128(b, k.rk[k.rounds]);
+}
+
+AEAD_TARGET inline void aes4(const AesKey& k, __m128i* x)
+{
+    for (size_t i = 0; i < 4; i++)
+        x[i] = _mm_xor_si128(x[i], k.rk[0]);
+    for (size_t r = 1; r < k.rounds; r++)
+        for (size_t i = 0; i < 4; i++)
+            x[i] = _mm_aesenc_si128(x[i], k.rk[r]);
+    for (size_t i = 0; i < 4; i++)
+        x[i] = _mm_aesenclast_si128(x[i], k.rk[k.rounds]);
+}
+
+// 读取不足一个分组的数据, 其余字节补 0
+inline __m128i load_partial(const uint8_t* data, size_t size)
+{
+    alignas(16) uint8_t buf[16] = {};
+    memcpy(buf, data, size);
+    return _mm_load_si128((const __m128i*)buf);
+}
+
+inline void store_partial(uint8_t* data, size_t size, __m128i block)
+{
+    alignas(16) uint8_t buf[16];
+    _mm_store_si128((__m128i*)buf, block);
+    memcpy(data, buf, size);
+}
+
+inline bool tag_equal(__m128i a, const uint8_t* tag, size_t size)
+{
+    alignas(16) uint8_t buf[16];
+    _mm_store_si128((__m128i*)buf, a);
+    uint8_t diff = 0;
+    for (size_t i = 0; i < size; i++)
+        diff |= buf[i] ^ tag[i];
+    return diff == 0;
+}
+
+/**
+ * @brief CTR 模式的计数器分组: 前缀 + 大端序的计数器, 计数器占最后 4 字节中 mask 对应的位
+ *
+ * @note GCM 的计数器为 32 位; CCM 的计数器只有 L 字节, 最后 4 字节的其余部分属于 nonce, 由 fixed 保留
+ */
+struct Counter
+{
+    __m128i  prefix;
+    uint32_t fixed = 0;
+    uint32_t mask  = UINT32_MAX;
+
+    AEAD_TARGET __m128i at(uint32_t i) const
+    {
+        return _mm_insert_epi32(prefix, (int)__builtin_bswap32(fixed | (i & mask)), 3);
+    }
+};
+
+/**
+ * @brief GF(2^128) 乘法, 输入输出均为字节序翻转后的值
+ *
+ * @note Intel Carry-Less Multiplication Instruction and its Usage for Computing the GCM Mode, Algorithm 5
+ */
+AEAD_TARGET __m128i gfmul(__m128i a, __m128i b)
+{
+    __m128i t3 = _mm_clmulepi64_si128(a, b, 0x00);
+    __m128i t4 = _mm_clmulepi64_si128(a, b, 0x10);
+    __m128i t5 = _mm_clmulepi64_si128(a, b, 0x01);
+    __m128i t6 = _mm_clmulepi64_si128(a, b, 0x11);
+
+    t4         = _mm_xor_si128(t4, t5);
+    t5         = _mm_slli_si128(t4, 8);
+    t4         = _mm_srli_si128(t4, 8);
+    t3         = _mm_xor_si128(t3, t5);
+    t6         = _mm_xor_si128(t6, t4);
+
+    // 整体左移 1 位
+    __m128i t7 = _mm_srli_epi32(t3, 31);
+    __m128i t8 = _mm_srli_epi32(t6, 31);
+    t3         = _mm_slli_epi32(t3, 1);
+    t6         = _mm_slli_epi32(t6, 1);
+    __m128i t9 = _mm_srli_si128(t7, 12);
+    t8         = _mm_slli_si128(t8, 4);
+    t7         = _mm_slli_si128(t7, 4);
+    t3         = _mm_or_si128(t3, t7);
+    t6         = _mm_or_si128(t6, t8);
+    t6         = _mm_or_si128(t6, t9);
+
+    // 模 x^128 + x^7 + x^2 + x + 1 约减
+    t7         = _mm_slli_epi32(t3, 31);
+    t8         = _mm_slli_epi32(t3, 30);
+    t9         = _mm_slli_epi32(t3, 25);
+    t7         = _mm_xor_si128(t7, t8);
+    t7         = _mm_xor_si128(t7, t9);
+    t8         = _mm_srli_si128(t7, 4);
+    t7         = _mm_slli_si128(t7, 12);
+    t3         = _mm_xor_si128(t3, t7);
+
+    __m128i t2 = _mm_srli_epi32(t3, 1);
+    t4         = _mm_srli_epi32(t3, 2);
+    t5         = _mm_srli_epi32(t3, 7);
+    t2         = _mm_xor_si128(t2, t4);
+    t2         = _mm_xor_si128(t2, t5);
+    t2         = _mm_xor_si128(t2, t8);
+    t3         = _mm_xor_si128(t3, t2);
+    return _mm_xor_si128(t6, t3);
+}
+
+AEAD_TARGET inline __m128i bswap128(__m128i x)
+{
+    return _mm_shuffle_epi8(x, _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+}
+
+/**
+ * @brief GCM 的 CTR 加解密与 GHASH, 每次处理 4 个分组
+ *
+ * @param h 字节序翻转后的 H
+ * @param x [in/out]字节序翻转后的 GHASH 状态
+ * @param encrypt 加密时对输出计算 GHASH, 解密时对输入计算
+ */
+AEAD_TARGET void gcm_ctr(const AesKey& k, const Counter& counter, uint8_t* data, size_t size, __m128i h, __m128i& x,
+                         bool encrypt)
+{
+    uint32_t i = 2;
+    for (; size >= 64; size -= 64, data += 64, i += 4)
+    {
+        __m128i ks[4] = {counter.at(i), counter.at(i + 1), counter.at(i + 2), counter.at(i + 3)};
+        aes4(k, ks);
+        for (size_t j = 0; j < 4; j++)
+        {
+            __m128i in  = _mm_loadu_si128((const __m128i*)(data + 16 * j));
+            __m128i out = _mm_xor_si128(in, ks[j]);
+            _mm_storeu_si128((__m128i*)(data + 16 * j), out);
+            x = gfmul(_mm_xor_si128(x, bswap128(encrypt ? out : in)), h);
+        }
+    }
+    for (; size >= 16; size -= 16, data += 16, i++)
+    {
+        __m128i in  = _mm_loadu_si128((const __m128i*)data);
+        __m128i out = _mm_xor_si128(in, aes(k, counter.at(i)));
+        _mm_storeu_si128((__m128i*)data, out);
+        x = gfmul(_mm_xor_si128(x, bswap128(encrypt ? out : in)), h);
+    }
+    if (size > 0)
+    {
+        __m128i in  = load_partial(data, size);
+        __m128i out = _mm_xor_si128(in, aes(k, counter.at(i)));
+        store_partial(data, size, out);
+        // 密文补 0 后参与认证
+        x = gfmul(_mm_xor_si128(x, bswap128(encrypt ? load_partial(data, size) : in)), h);
+    }
+}
+
+/**
+ * @brief GCM, 计数器初值 J0 = nonce || 1, 数据从 J0 + 1 开始
+ *
+ * @return __m128i 完整的 16 字节 tag
+ */
+AEAD_TARGET __m128i gcm(const AesKey& k, const NonceType& nonce, uint8_t* data, size_t size, bool encrypt)
+{
+    Counter counter;
+    counter.prefix = load_partial(nonce.data(), nonce.size());
+
+    // H = E(K, 0), S = E(K, J0)
+    __m128i h = _mm_setzero_si128();
+    __m128i s = counter.at(1);
+    aes2(k, h, s);
+    h         = bswap128(h);
+
+    __m128i x = _mm_setzero_si128();
+    gcm_ctr(k, counter, data, size, h, x, encrypt);
+
+    // 长度分组: len(A) || len(C), 以比特计
+    __m128i len = _mm_set_epi64x((long long)__builtin_bswap64((uint64_t)size * 8), 0);
+    x           = gfmul(_mm_xor_si128(x, bswap128(len)), h);
+    return _mm_xor_si128(bswap128(x), s);
+}
+
+/**
+ * @brief CCM, L = 15 - nonce 长度; CBC-MAC 与 CTR 的分组交错计算
+ *
+ * @return __m128i 完整的 16 字节 tag
+ */
+AEAD_TARGET __m128i ccm(const AesKey& k, const CipherSuite& suite, const NonceType& nonce, uint8_t* data, size_t size,
+                        bool encrypt)
+{
+    constexpr uint8_t L          = 15 - sizeof(NonceType);
+
+    alignas(16) uint8_t b0[16]   = {};
+    b0[0]                        = (L - 1) | (((suite.tag_size() - 2) / 2) << 3);
+    memcpy(&b0[1], nonce.data(), nonce.size());
+    for (size_t i = 0; i < L; i++)
+        b0[15 - i] = (size >> (8 * i)) & 0xFF;
+
+    alignas(16) uint8_t a0[16] = {};
+    a0[0]                      = L - 1;
+    memcpy(&a0[1], nonce.data(), nonce.size());
+
+    static_assert(L < 4, "CCM counter must fit in the last word");
+    Counter counter;
+    counter.prefix = _mm_load_si128((const __m128i*)a0);
+    counter.mask   = (1u << (8 * L)) - 1;
+    memcpy(&counter.fixed, &a0[12], sizeof(counter.fixed));
+    counter.fixed = __builtin_bswap32(counter.fixed) & ~counter.mask;
+
+    __m128i mac = _mm_load_si128((const __m128i*)b0);
+    __m128i s0  = counter.at(0);
+    aes2(k, mac, s0);
+
+    uint32_t i = 1;
+    for (; size >= 16; size -= 16, data += 16, i++)
+    {
+        __m128i in = _mm_loadu_si128((const __m128i*)data);
+        __m128i ks = counter.at(i);
+        if (encrypt)
+        {
+            // 明文已知, MAC 与密钥流并行
+            mac = _mm_xor_si128(mac, in);
+            aes2(k, mac, ks);
+            _mm_storeu_si128((__m128i*)data, _mm_xor_si128(in, ks));
+        }
+        else
+        {
+            __m128i out = _mm_xor_si128(in, aes(k, ks));
+            _mm_storeu_si128((__m128i*)data, out);
+            mac = aes(k, _mm_xor_si128(mac, out));
+        }
+    }
+    if (size > 0)
+    {
+        __m128i in  = load_partial(data, size);
+        __m128i out = _mm_xor_si128(in, aes(k, counter.at(i)));
+        store_partial(data, size, out);
+        mac = aes(k, _mm_xor_si128(mac, encrypt ? in : load_partial(data, size)));
+    }
+    return _mm_xor_si128(mac, s0);
+}
+} // namespace
+
+AEAD_TARGET void aead_encrypt_hw(const CipherSuite& suite, const KeyType& key, const NonceType& nonce, uint8_t* data,
+                                 size_t size, uint8_t* tag)
+{
+    AesKey k;
+    expand_key(suite, key, k);
+    __m128i full = suite.mode == CipherMode::GCM ? gcm(k, nonce, data, size, true) : ccm(k, suite, nonce, data, size, true);
+    store_partial(tag, suite.tag_size(), full);
+}
+
+AEAD_TARGET bool aead_decrypt_hw(const CipherSuite& suite, const KeyType& key, const NonceType& nonce, uint8_t* data,
+                                 size_t size, const uint8_t* tag)
+{
+    AesKey k;
+    expand_key(suite, key, k);
+    __m128i full =
+        suite.mode == CipherMode::GCM ? gcm(k, nonce, data, size, false) : ccm(k, suite, nonce, data, size, false);
+    return tag_equal(full, tag, suite.tag_size());
+}
+
+bool aead_hw_supported()
+{
+    static const bool supported =
+        __builtin_cpu_supports("aes") && __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1");
+    return supported;
+}
+#else
+void aead_encrypt_hw(const CipherSuite& suite, const KeyType& key, const NonceType& nonce, uint8_t* data, size_t size,
+                     uint8_t* tag)
+{
+    aead_encrypt_sw(suite, key, nonce, data, size, tag);
+}
+
+bool aead_decrypt_hw(const CipherSuite& suite, const KeyType& key, const NonceType& nonce, uint8_t* data, size_t size,
+                     const uint8_t* tag)
+{
+    return aead_decrypt_sw(suite, key, nonce, data, size, tag);
+}
+
+bool aead_hw_supported()
+{
+    return false;
+}
+#endif
+
+void aead_encrypt(const CipherSuite& suite, const KeyType& key, const NonceType& nonce, uint8_t* data, size_t size,
+                  uint8_t* tag)
+{
+    if (aead_hw_supported())
+        aead_encrypt_hw(suite, key, nonce, data, size, tag);
+    else
+        aead_encrypt_sw(suite, key, nonce, data, size, tag);
+}
+
+bool aead_decrypt(const CipherSuite& suite, const KeyType& key, const NonceType& nonce, uint8_t* data, size_t size,
+                  const uint8_t* tag)
+{
+    if (aead_hw_supported()) return aead_decrypt_hw(suite, key, nonce, data, size, tag);
+    return aead_decrypt_sw(suite, key, nonce, data, size, tag);
+}
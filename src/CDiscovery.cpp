@@ -0,0 +1,146 @@
+#include "CDiscovery.hpp"
+
+/**
+ * @brief 发现总线上的所有设备并依次分配地址
+ *
+ * @param client 客户端实例
+ * @param first 分配的第一个地址
+ * @return ErrorCode 错误码, 部分设备未能分配时返回 E_FAIL
+ */
+ErrorCode CDiscoveryBase::discover(HostClient& client, Address first)
+{
+    Address self  = client.address;
+    Extra&  extra = client.extra;
+
+    _count         = 0;
+    _next          = first;
+    _queries       = 0;
+    _unresolved    = 0;
+    client.address = ADDRESS_BROADCAST;
+
+    // 所有设备恢复为未分配状态
+    extra.reset();
+    client.send(Command::DISCOVER, extra);
+
+    DiscoverRequest req = {};
+    req.slots           = slots == 0 ? 1 : slots;
+    req.width           = width;
+    ErrorCode err       = search(client, req);
+
+    client.address = self;
+    if (err == ErrorCode::S_OK && _unresolved > 0) err = ErrorCode::E_FAIL;
+    return err;
+}
+
+/**
+ * @brief 查询前缀, 冲突时将前缀分为两半继续查询
+ *
+ */
+ErrorCode CDiscoveryBase::search(HostClient& client, DiscoverRequest req)
+{
+    bool      collided = false;
+    ErrorCode err      = query(client, req, collided);
+    if (err != ErrorCode::S_OK || !collided) return err;
+
+    // 唯一Id完全相同的设备无法区分
+    if (req.bits >= sizeof(UniqueId) * 8)
+    {
+        _unresolved++;
+        return ErrorCode::S_OK;
+    }
+
+    uint8_t index = req.bits / 8;
+    uint8_t mask  = 0x80 >> (req.bits % 8);
+    req.bits++;
+    req.prefix[index] &= ~mask;
+    if ((err = search(client, req)) != ErrorCode::S_OK) return err;
+    req.prefix[index] |= mask;
+    return search(client, req);
+}
+
+/**
+ * @brief 查询一次前缀, 并为应答的设备分配地址
+ *
+ * @param client 客户端实例
+ * @param req 查询请求
+ * @param collided [out]是否检测到冲突
+ * @return ErrorCode 错误码
+ */
+ErrorCode CDiscoveryBase::query(HostClient& client, DiscoverRequest& req, bool& collided)
+{
+    Command   cmd;
+    ErrorCode err;
+    Extra&    extra = client.extra;
+
+    req.seed = _seed++;
+    extra.reset();
+    extra.add(req);
+    LinkStats before = client.stats();
+    client.send(Command::DISCOVER, extra);
+    _queries++;
+
+    // 收集所有时隙的应答, 直到接收超时
+    size_t first    = _count;
+    bool   overflow = false;
+    while (client.recv(cmd, err, extra))
+    {
+        UniqueId uid;
+        if (cmd != Command::DISCOVER || err != ErrorCode::S_OK || extra.remain() != sizeof(uid)) continue;
+        extra.get(uid);
+        // 冲突后恰好通过校验的帧
+        if (!req.match(uid))
+        {
+            collided = true;
+            continue;
+        }
+        if (_count >= _devices_max)
+        {
+            overflow = true;
+            continue;
+        }
+        _uids[_count++] = uid;
+    }
+    const LinkStats& after = client.stats();
+    if (after.checksum != before.checksum || after.noise != before.noise) collided = true;
+
+    // 逐个分配地址, 分配失败的设备留给下一级前缀
+    size_t kept = first;
+    for (size_t i = first; i < _count; i++)
+    {
+        if (_next == ADDRESS_BROADCAST) return ErrorCode::E_OUT_OF_INDEX;
+        if (assign(client, _uids[i], _next) != ErrorCode::S_OK)
+        {
+            collided = true;
+            continue;
+        }
+        _uids[kept]        = _uids[i];
+        _addresses[kept++] = _next++;
+    }
+    _count = kept;
+    return overflow ? ErrorCode::E_OUT_OF_BUFFER : ErrorCode::S_OK;
+}
+
+/**
+ * @brief 为唯一Id对应的设备分配地址
+ *
+ * @param client 客户端实例
+ * @param uid 唯一Id
+ * @param target 地址
+ * @return ErrorCode 错误码
+ */
+ErrorCode CDiscoveryBase::assign(HostClient& client, const UniqueId& uid, Address target)
+{
+    ErrorCode err;
+    Extra&    extra = client.extra;
+
+    extra.reset();
+    extra.add(uid);
+    extra.add(target);
+    client.send(Command::ASSIGN, extra);
+    if (!client.recv_response(Command::ASSIGN, err, extra)) return ErrorCode::E_TIMEOUT;
+    if (err != ErrorCode::S_OK) return err;
+
+    UniqueId echo;
+    if (extra.remain() != sizeof(echo) || !extra.get(echo) || echo != uid) return ErrorCode::E_FAIL;
+    return ErrorCode::S_OK;
+}
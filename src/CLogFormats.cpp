@@ -0,0 +1,224 @@
+#include "CLogFormats.hpp"
+#include <algorithm>
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @brief 从 Server 获取日志格式表
+ *
+ * @param client 客户端实例
+ * @return ErrorCode 错误码
+ */
+ErrorCode CLogFormatsBase::refresh(HostClient& client)
+{
+    ErrorCode  err;
+    Extra&     extra = client.extra;
+    PropertyId id;
+    Size       count;
+
+    _loaded = 0;
+    if ((err = client.holder.get_id_by_name(name, id)) != ErrorCode::S_OK) return err;
+
+    // 获取格式个数
+    extra.reset();
+    extra.add(id);
+    client.send(Command::GET_SIZE, extra, false);
+    if (!client.recv_response(Command::GET_SIZE, err, extra)) return ErrorCode::E_TIMEOUT;
+    if (err != ErrorCode::S_OK) return err;
+    if (!extra.get(count)) return ErrorCode::E_FAIL;
+    if (count > _capacity) return ErrorCode::E_OUT_OF_BUFFER;
+
+    // 逐个获取格式字符串
+    _offsets[0] = 0;
+    for (Size i = 0; i < count; i++)
+    {
+        extra.reset();
+        extra.add(id);
+        extra.add<LogFormatId>(i);
+        client.send(Command::GET_PROPERTY, extra, false);
+        if (!client.recv_response(Command::GET_PROPERTY, err, extra)) return ErrorCode::E_TIMEOUT;
+        if (err != ErrorCode::S_OK) return err;
+
+        Size len = extra.remain();
+        if (_offsets[i] + len > _pool_size) return ErrorCode::E_OUT_OF_BUFFER;
+        memcpy(&_pool[_offsets[i]], extra.curr(), len);
+        _offsets[i + 1] = _offsets[i] + len;
+        _loaded         = i + 1;
+    }
+    return ErrorCode::S_OK;
+}
+
+/**
+ * @brief 获取已缓存的格式个数
+ *
+ * @return Size 格式个数
+ */
+Size CLogFormatsBase::size() const
+{
+    return _loaded;
+}
+
+/**
+ * @brief 将二进制日志展开为文本
+ *
+ * @note 参数的解包规则见 LogArgs, 转换说明中的长度修饰符被忽略, 参数长度由打包时的类型决定
+ *
+ * @param log 日志内容 {LogFormatId,打包的参数}
+ * @param size 日志长度
+ * @param out 接收文本的缓冲区, 以 '\0' 结尾
+ * @param capacity 缓冲区长度
+ * @return size_t 文本长度, 不含 '\0'
+ */
+size_t CLogFormatsBase::expand(const uint8_t* log, size_t size, char* out, size_t capacity) const
+{
+    if (capacity == 0) return 0;
+
+    size_t n    = 0;
+    auto   put  = [&](const char* str, size_t len)
+    {
+        len = std::min(len, capacity - 1 - n);
+        memcpy(&out[n], str, len);
+        n += len;
+    };
+    size_t pos  = 0;
+    auto   take = [&](void* value, size_t len)
+    {
+        if (pos + len > size) return false;
+        memcpy(value, &log[pos], len);
+        pos += len;
+        return true;
+    };
+    // 带长度的整数, 按转换说明符号扩展或零扩展到 64 位
+    auto take_int = [&](uint64_t& value, bool sign)
+    {
+        uint8_t width;
+        if (!take(&width, sizeof(width))) return false;
+        if (width != 1 && width != 2 && width != 4 && width != 8) return false;
+        value = 0;
+        if (!take(&value, width)) return false;
+        if (sign && width < sizeof(value))
+        {
+            size_t shift = 64 - 8 * width;
+            value        = (uint64_t)((int64_t)(value << shift) >> shift);
+        }
+        return true;
+    };
+
+    LogFormatId id;
+    if (!take(&id, sizeof(id)) || id >= _loaded)
+    {
+        put("<unknown log format>", 20);
+        out[n] = '\0';
+        return n;
+    }
+
+    const char* fmt = &_pool[_offsets[id]];
+    size_t      end = _offsets[id + 1] - _offsets[id];
+    for (size_t i = 0; i < end;)
+    {
+        if (fmt[i] != '%')
+        {
+            put(&fmt[i++], 1);
+            continue;
+        }
+        if (i + 1 < end && fmt[i + 1] == '%')
+        {
+            put("%", 1);
+            i += 2;
+            continue;
+        }
+
+        // 标志, 宽度, 精度
+        size_t j = i + 1;
+        while (j < end && strchr("-+ #0", fmt[j]))
+            j++;
+        while (j < end && fmt[j] >= '0' && fmt[j] <= '9')
+            j++;
+        if (j < end && fmt[j] == '.')
+            for (j++; j < end && fmt[j] >= '0' && fmt[j] <= '9'; j++)
+                ;
+        size_t prefix = j - i;
+        // 长度修饰符, 参数长度已随参数打包
+        while (j < end && strchr("hlLzjt", fmt[j]))
+            j++;
+        if (j >= end || prefix + 3 > 16) break;
+        char conv = fmt[j++];
+
+        // 以本机的类型重新生成转换说明
+        char spec[16];
+        memcpy(spec, &fmt[i], prefix);
+        spec[prefix] = '\0';
+
+        char tmp[64];
+        int  len = -1;
+        switch (conv)
+        {
+        case 'd':
+        case 'i':
+        case 'u':
+        case 'x':
+        case 'X':
+        case 'o':
+        {
+            uint64_t value;
+            bool     sign   = conv == 'd' || conv == 'i';
+            char     tail[] = {'l', 'l', conv, '\0'};
+            if (!take_int(value, sign)) break;
+            strcat(spec, tail);
+            len = sign ? snprintf(tmp, sizeof(tmp), spec, (long long)value)
+                       : snprintf(tmp, sizeof(tmp), spec, (unsigned long long)value);
+            break;
+        }
+        case 'c':
+        {
+            uint64_t value;
+            if (!take_int(value, false)) break;
+            strcat(spec, "c");
+            len = snprintf(tmp, sizeof(tmp), spec, (int)(char)value);
+            break;
+        }
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+        {
+            double value;
+            if (!take(&value, sizeof(value))) break;
+            char tail[] = {conv, '\0'};
+            strcat(spec, tail);
+            len = snprintf(tmp, sizeof(tmp), spec, value);
+            break;
+        }
+        case 's':
+        {
+            // 字符串忽略宽度和精度
+            uint8_t count;
+            if (!take(&count, sizeof(count)) || pos + count > size) break;
+            put((const char*)&log[pos], count);
+            pos += count;
+            len = 0;
+            break;
+        }
+        default:
+            // 不支持的转换说明原样输出
+            put(&fmt[i], j - i);
+            len = 0;
+            break;
+        }
+        if (len < 0)
+        {
+            // 参数不足
+            put("<?>", 3);
+            break;
+        }
+        put(tmp, std::min<size_t>(len, sizeof(tmp) - 1));
+        i = j;
+    }
+
+    out[n] = '\0';
+    return n;
+}
@@ -0,0 +1,107 @@
+#include "CScope.hpp"
+#include <string.h>
+
+/**
+ * @brief 配置并开始采样
+ *
+ * @param client 客户端实例
+ * @param names 采样的属性名
+ * @param divider 分频系数
+ * @return ErrorCode 错误码
+ */
+ErrorCode CScopeBase::start(HostClient& client, std::initializer_list<frozen::string> names, uint16_t divider)
+{
+    if (names.size() == 0) return ErrorCode::E_INVALID_ARG;
+    if (names.size() > _channels_max) return ErrorCode::E_OUT_OF_INDEX;
+
+    ErrorCode err;
+    Extra&    extra = client.extra;
+    extra.reset();
+    extra.add(divider);
+    for (auto& name : names)
+    {
+        PropertyId id;
+        if ((err = client.holder.get_id_by_name(name, id)) != ErrorCode::S_OK) return err;
+        extra.add(id);
+    }
+    // 先清空, 配置成功后立即开始接收
+    _count = 0;
+    clear();
+    client.send(Command::SET_SCOPE, extra, false);
+    if (!client.recv_response(Command::SET_SCOPE, err, extra)) return ErrorCode::E_TIMEOUT;
+    if (err != ErrorCode::S_OK) return err;
+    if (extra.remain() != names.size()) return ErrorCode::E_FAIL;
+
+    _row = 0;
+    for (size_t i = 0; i < names.size(); i++)
+    {
+        extra.get(_widths[i]);
+        if (_widths[i] == 0 || _widths[i] > SCOPE_WIDTH_MAX) return ErrorCode::E_FAIL;
+        _row += _widths[i];
+    }
+    _count = names.size();
+    return ErrorCode::S_OK;
+}
+
+/**
+ * @brief 停止采样
+ *
+ * @param client 客户端实例
+ * @return ErrorCode 错误码
+ */
+ErrorCode CScopeBase::stop(HostClient& client)
+{
+    ErrorCode err;
+    Extra&    extra = client.extra;
+    extra.reset();
+    extra.add<uint16_t>(0);
+    client.send(Command::SET_SCOPE, extra, false);
+    if (!client.recv_response(Command::SET_SCOPE, err, extra)) return ErrorCode::E_TIMEOUT;
+    return err;
+}
+
+/**
+ * @brief 接收一块采样数据, 由 HostClient 处理 SCOPE_DATA 帧时调用
+ *
+ * @param extra 附加参数
+ */
+void CScopeBase::receive(Extra& extra)
+{
+    uint16_t seq;
+    if (_count == 0 || !extra.get(seq)) return;
+    // 检查块序号是否连续
+    if (_synced && seq != _next) _lost += (uint16_t)(seq - _next);
+    _synced = true;
+    _next   = seq + 1;
+
+    while (extra.remain() >= _row && _size < _depth_max)
+    {
+        for (size_t i = 0; i < _count; i++)
+        {
+            extra.get(&_columns[i * _depth_max * SCOPE_WIDTH_MAX + _size * _widths[i]], _widths[i]);
+        }
+        _size++;
+    }
+}
+
+/**
+ * @brief 清空已接收的采样数据
+ *
+ */
+void CScopeBase::clear()
+{
+    _size   = 0;
+    _synced = false;
+    _lost   = 0;
+}
+
+/**
+ * @brief 获取列
+ *
+ * @param channel 通道
+ * @return const uint8_t* 列的首地址
+ */
+const uint8_t* CScopeBase::column(size_t channel) const
+{
+    return &_columns[channel * _depth_max * SCOPE_WIDTH_MAX];
+}
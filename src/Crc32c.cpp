@@ -0,0 +1,92 @@
+#include "Crc32c.hpp"
+#include <array>
+#include <string.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+  #define CRC32C_X86 1
+  #include <nmmintrin.h>
+#else
+  #define CRC32C_X86 0
+#endif
+
+// CRC-32C 多项式(反转)
+#define CRC32C_POLY 0x82F63B78ul
+
+static constexpr std::array<uint32_t, 256> crc32c_table = []()
+{
+    std::array<uint32_t, 256> table;
+    for (uint32_t i = 0; i < table.size(); i++)
+    {
+        uint32_t crc = i;
+        for (size_t j = 0; j < 8; j++)
+        {
+            crc = (crc >> 1) ^ (crc & 1 ? CRC32C_POLY : 0);
+        }
+        table[i] = crc;
+    }
+    return table;
+}();
+
+uint32_t crc32c_sw(uint32_t crc, const void* data, size_t size)
+{
+    const uint8_t* ptr = (const uint8_t*)data;
+    crc                = ~crc;
+    for (size_t i = 0; i < size; i++)
+    {
+        crc = (crc >> 8) ^ crc32c_table[(crc ^ ptr[i]) & 0xFF];
+    }
+    return ~crc;
+}
+
+#if CRC32C_X86
+__attribute__((target("sse4.2"))) uint32_t crc32c_hw(uint32_t crc, const void* data, size_t size)
+{
+    const uint8_t* ptr = (const uint8_t*)data;
+    crc                = ~crc;
+    // 按字长计算
+  #if defined(__x86_64__)
+    uint64_t crc64 = crc;
+    for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t), ptr += sizeof(uint64_t))
+    {
+        uint64_t word;
+        memcpy(&word, ptr, sizeof(word));
+        crc64 = _mm_crc32_u64(crc64, word);
+    }
+    crc = (uint32_t)crc64;
+  #endif
+    for (; size >= sizeof(uint32_t); size -= sizeof(uint32_t), ptr += sizeof(uint32_t))
+    {
+        uint32_t word;
+        memcpy(&word, ptr, sizeof(word));
+        crc = _mm_crc32_u32(crc, word);
+    }
+    // 余下的字节
+    for (; size > 0; size--, ptr++)
+    {
+        crc = _mm_crc32_u8(crc, *ptr);
+    }
+    return ~crc;
+}
+
+bool crc32c_hw_supported()
+{
+    static const bool supported = __builtin_cpu_supports("sse4.2");
+    return supported;
+}
+#else
+uint32_t crc32c_hw(uint32_t crc, const void* data, size_t size)
+{
+    return crc32c_sw(crc, data, size);
+}
+
+bool crc32c_hw_supported()
+{
+    return false;
+}
+#endif
+
+uint32_t crc32c(uint32_t crc, const void* data, size_t size)
+{
+    if (crc32c_hw_supported()) return crc32c_hw(crc, data, size);
+    return crc32c_sw(crc, data, size);
+}
@@ -1,5 +1,6 @@
 #include "HostBase.hpp"
 #include <checksum.h>
+#include <Crc32c.hpp>
 #include <string.h>
 
 #if defined(__GNUC__) || defined(__clang__)
@@ -25,6 +26,8 @@ bool HostBase::sync(Header& head)
     {
         uint8_t byte;
         if (!rx(byte)) return false; // 接收超时
+        // 缓冲区已满时弹出的字节不属于任何有效帧
+        if (_buf_head.full()) _stats.noise++;
         _buf_head.push(byte);
     }
 
@@ -38,69 +41,174 @@ bool HostBase::sync(Header& head)
  * @param cmd [out]接收到的命令
  * @param err [out]错误码
  * @param extra [out]附加参数
+ * @param direct [in/out]直接接收缓冲区, 可为空
  * @return true 成功接收一帧
  * @return false 接收超时
  */
-bool HostBase::recv(Command& cmd, ErrorCode& err, Extra& extra)
+bool HostBase::recv(Command& cmd, ErrorCode& err, Extra& extra, DirectBuffer* direct)
 {
 Start:
     Header head;
     if (!sync(head)) return false;
 
-    cmd = REMOVE_ENCRYPT_MARK(head.cmd);
-    err = head.error;
+    cmd     = REMOVE_ENCRYPT_MARK(head.cmd);
+    err     = head.error;
+    _target = head.address;
     extra.reset();
+
+    // 帧头已通过校验, 其他地址的帧和超长的帧直接跳过附加参数, 不写入缓冲区也不计算校验和
+    bool direct_fit = direct && direct->cmd == cmd && head.size == direct->size;
+    bool oversize   = head.size > extra.capacity() && !direct_fit;
+    bool foreign    = !accepts(head.address);
+    if (foreign || oversize)
+    {
+        // 链路参数由整条总线共用(见 SET_LINK), 按本机参数计算的长度即为其他设备的帧长
+        size_t tail = 0;
+        if (head.size > 0)
+        {
+            tail = head.size + (_checksum == ChecksumType::CRC16 ? sizeof(Checksum) : sizeof(uint32_t));
+            if (IS_ENCRYPTED(head.cmd)) tail += _cipher.tag_size();
+        }
+        if (!skip(tail)) return false; // 接收超时
+        _stats.skipped += tail;
+
+        if (foreign)
+        {
+            _stats.foreign++;
+            goto Start;
+        }
+        // 本机的超长帧立即拒绝
+        _stats.oversize++;
+        if (direct) direct->used = false;
+        err = ErrorCode::E_OUT_OF_BUFFER;
+        return true;
+    }
+
     extra.size()      = std::min(head.size, extra.capacity());
     extra.encrypted() = IS_ENCRYPTED(head.cmd) && extra.size() > 0;
 
+    // 附加参数的写入位置
+    uint8_t* data = extra.data();
+    Size     size = extra.size();
+    if (direct)
+    {
+        direct->used = direct->cmd == cmd && err == ErrorCode::S_OK && !extra.encrypted() && head.size > 0 &&
+                       head.size == direct->size;
+        if (direct->used)
+        {
+            data         = direct->data;
+            size         = head.size;
+            extra.size() = 0;
+        }
+    }
+
     // 数据长度为 0 则跳过读取
-    if (extra.size() == 0)
+    if (size == 0)
         goto End;
     else
     {
         uint16_t chksum = CRC_START_CCITT_FFFF;
+        bool     crc16  = _checksum == ChecksumType::CRC16;
         // 读取tag
         if (extra.encrypted())
         {
-            for (size_t i = 0; i < sizeof(TagType); i++)
+            uint8_t* tag = extra.tag(_cipher.tag_size());
+            for (size_t i = 0; i < _cipher.tag_size(); i++)
             {
                 uint8_t byte;
                 if (!rx(byte)) return false; // 接收超时
-                chksum         = update_crc_ccitt(chksum, byte);
-                extra.tag()[i] = byte;
+                if (crc16) chksum = update_crc_ccitt(chksum, byte);
+                tag[i] = byte;
             }
         }
 
         // 读取数据
-        for (size_t i = 0; i < extra.size(); i++)
+        for (size_t i = 0; i < size; i++)
         {
             uint8_t byte;
             if (!rx(byte)) return false; // 接收超时
-            chksum          = update_crc_ccitt(chksum, byte);
-            extra.data()[i] = byte;
+            if (crc16) chksum = update_crc_ccitt(chksum, byte);
+            data[i] = byte;
         }
 
-        // 读取校验和
-        for (size_t i = 0; i < sizeof(chksum); i++)
+        if (crc16)
         {
-            uint8_t byte;
-            if (!rx(byte)) return false; // 接收超时
-            chksum = update_crc_ccitt(chksum, byte);
+            // 读取校验和
+            for (size_t i = 0; i < sizeof(chksum); i++)
+            {
+                uint8_t byte;
+                if (!rx(byte)) return false; // 接收超时
+                chksum = update_crc_ccitt(chksum, byte);
+            }
+
+            // 验证数据
+            if (chksum != 0)
+            {
+                _stats.checksum++;
+                goto Start;
+            }
         }
+        else
+        {
+            // 读取校验和
+            uint32_t crc;
+            for (size_t i = 0; i < sizeof(crc); i++)
+            {
+                uint8_t byte;
+                if (!rx(byte)) return false; // 接收超时
+                ((uint8_t*)&crc)[i] = byte;
+            }
 
-        // 验证数据
-        if (chksum != 0) goto Start;
+            // 验证数据
+            uint32_t calc = 0;
+            if (extra.encrypted()) calc = crc32c(calc, extra.tag(_cipher.tag_size()), _cipher.tag_size());
+            calc = crc32c(calc, data, size);
+            if (calc != crc)
+            {
+                _stats.checksum++;
+                goto Start;
+            }
+        }
     }
 End:
-    // 验证地址
-    if (head.address != address) goto Start;
+    _stats.frames++;
+    return true;
+}
 
+/**
+ * @brief 丢弃接收到的字节
+ *
+ * @param size 丢弃的字节数
+ * @return true 接收成功
+ * @return false 接收超时
+ */
+bool HostBase::skip(size_t size)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        uint8_t byte;
+        if (!rx(byte)) return false;
+    }
     return true;
 }
 
+/**
+ * @brief 是否接收发往目标地址的帧
+ *
+ * @param target 帧头中的地址
+ * @return true 接收
+ * @return false 跳过
+ */
+bool HostBase::accepts(Address target) const
+{
+    return target == address;
+}
+
 /**
  * @brief 发送数据帧
  *
+ * @note 整帧在发送锁内发送, 不会与其他任务发送的帧交错
+ *
  * @param head 帧头
  * @param extra 附加参数
  * @param size 附加参数长度
@@ -110,6 +218,8 @@ void HostBase::send(const Header& head, const void* extra, uint16_t size)
     Checksum chksum = crc_ccitt_ffff((uint8_t*)&head, sizeof(head));
     // 注意: CRC-16 校验和大小端翻转后, 在接收端计算时才会为 0
     chksum          = __REV16(chksum);
+
+    LockGuard guard(_tx_lock);
     tx(&head, sizeof(head));
     tx(&chksum, sizeof(chksum));
 
@@ -119,6 +229,12 @@ void HostBase::send(const Header& head, const void* extra, uint16_t size)
     // 发送额外参数
     tx(extra, size);
     // 计算并发送数据校验和
+    if (_checksum == ChecksumType::CRC32C)
+    {
+        uint32_t crc = crc32c(0, extra, size);
+        tx(&crc, sizeof(crc));
+        return;
+    }
     chksum = crc_ccitt_ffff((uint8_t*)extra, size);
     // 注意: CRC-16 校验和大小端翻转后, 在接收端计算时才会为 0
     chksum = __REV16(chksum);
@@ -134,17 +250,128 @@ void HostBase::send(const Header& head, const void* extra, uint16_t size)
  * @param err 错误码
  */
 void HostBase::send(Command cmd, Extra& extra, bool encrypt, ErrorCode err)
+{
+    send_to(address, cmd, extra, encrypt, err);
+}
+
+/**
+ * @brief 向指定地址发送数据帧
+ *
+ * @note Client 向广播/组播地址发送时, Server 不应答
+ *
+ * @param target 目标地址
+ * @param cmd 请求的指令
+ * @param extra 附加参数
+ * @param encrypt 是否加密?
+ * @param err 错误码
+ */
+void HostBase::send_to(Address target, Command cmd, Extra& extra, bool encrypt, ErrorCode err)
 {
     // 截断多余的数据
     extra.truncate();
-    if (encrypt) extra.encrypt(secret.nonce, secret.key);
+    if (encrypt) extra.encrypt(secret.nonce, secret.key, _cipher);
     Header head;
-    head.address = address;
+    head.address = target;
     head.cmd     = extra.encrypted() ? ADD_ENCRYPT_MARK(cmd) : REMOVE_ENCRYPT_MARK(cmd);
     head.error   = err;
     head.size    = extra.size();
     if (extra.encrypted())
-        send(head, extra.tag(), extra.size() + sizeof(TagType));
+        send(head, extra.tag(_cipher.tag_size()), extra.size() + _cipher.tag_size());
     else
         send(head, extra.data(), extra.size());
-}
\ No newline at end of file
+}
+
+/**
+ * @brief 直接发送数据帧
+ *
+ * @note 数据不经过附加参数缓冲区, 直接从 data 发送, 因此不能加密
+ *
+ * @param cmd 请求的指令
+ * @param data 附加参数
+ * @param size 附加参数长度
+ * @param err 错误码
+ */
+void HostBase::send_direct(Command cmd, const void* data, Size size, ErrorCode err)
+{
+    Header head;
+    head.address = address;
+    head.cmd     = REMOVE_ENCRYPT_MARK(cmd);
+    head.error   = err;
+    head.size    = size;
+    send(head, data, size);
+}
+
+/**
+ * @brief 发送预先生成的完整数据帧
+ *
+ * @note 帧头和校验和已包含在 frame 中, 以一次 tx 发送
+ *
+ * @param frame 数据帧
+ * @param size 数据帧长度
+ */
+void HostBase::send_frame(const void* frame, size_t size)
+{
+    LockGuard guard(_tx_lock);
+    tx(frame, size);
+}
+
+/**
+ * @brief 检查链路参数是否有效
+ *
+ * @param option 链路参数
+ * @param value 参数值
+ * @return ErrorCode 错误码
+ */
+ErrorCode HostBase::check_link(LinkOption option, uint8_t value) const
+{
+    switch (option)
+    {
+    case LinkOption::CHECKSUM:
+        if (value != (uint8_t)ChecksumType::CRC16 && value != (uint8_t)ChecksumType::CRC32C)
+            return ErrorCode::E_INVALID_ARG;
+        return ErrorCode::S_OK;
+    case LinkOption::CIPHER:
+    {
+        CipherSuite suite;
+        if (!CipherSuite::decode(value, suite)) return ErrorCode::E_INVALID_ARG;
+        // 请求与应答使用同一随机数, GCM 重用 (密钥, 随机数) 会泄露认证密钥, 在随机数区分方向之前不提供
+        if (suite.mode == CipherMode::GCM) return ErrorCode::E_NO_IMPLEMENT;
+        return ErrorCode::S_OK;
+    }
+    default:
+        return ErrorCode::E_NO_IMPLEMENT;
+    }
+}
+
+/**
+ * @brief 设置链路参数
+ *
+ * @note 调用前应当使用 check_link 检查参数
+ *
+ * @param option 链路参数
+ * @param value 参数值
+ */
+void HostBase::apply_link(LinkOption option, uint8_t value)
+{
+    switch (option)
+    {
+    case LinkOption::CHECKSUM:
+        _checksum = (ChecksumType)value;
+        break;
+    case LinkOption::CIPHER:
+        CipherSuite::decode(value, _cipher);
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief 将链路参数恢复为默认值
+ *
+ */
+void HostBase::default_link()
+{
+    _checksum = ChecksumType::CRC16;
+    _cipher   = CipherSuite();
+}
@@ -1,4 +1,9 @@
 #include "HostClient.hpp"
+#include <algorithm>
+#include <array>
+#include <CLogFormats.hpp>
+#include <CRecorder.hpp>
+#include <CScope.hpp>
 #include <cstdint>
 
 /**
@@ -7,26 +12,227 @@
  * @param cmd 期望的命令
  * @param err 错误码
  * @param extra 附加参数
+ * @param direct 直接接收缓冲区, 可为空
  * @return true 成功接收一帧
  * @return false 接收超时
  */
-bool HostClient::recv_response(Command cmd, ErrorCode& err, Extra& extra)
+bool HostClient::recv_response(Command cmd, ErrorCode& err, Extra& extra, DirectBuffer* direct)
 {
 Start:
     Command r_cmd;
-    if (!recv(r_cmd, err, extra)) return false;
+    if (!recv(r_cmd, err, extra, direct)) return false;
 
     // 验证命令
     if (r_cmd != cmd)
     {
-        // 输出 log 信息
-        if (r_cmd == Command::LOG)
+        if (is_async(r_cmd))
         {
-            uint8_t level;
-            if (!extra.get(level)) goto Start;
-            log_output((LogLevel)level, extra.curr(), extra.remain());
+            // 交给消费者处理, 不阻塞等待中的事务
+            if (async)
+                async->push(r_cmd, extra.curr(), extra.remain());
+            else
+                handle_async(r_cmd, extra);
         }
         goto Start;
     }
     return true;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief 处理一个队列中的异步帧, 由消费者调用
+ *
+ * @return true 处理了一帧
+ * @return false 队列为空或未设置队列
+ */
+bool HostClient::dispatch()
+{
+    Command cmd;
+    if (!async || !async->pop(cmd, _async_extra)) return false;
+    handle_async(cmd, _async_extra);
+    return true;
+}
+
+/**
+ * @brief 将读取到的属性值写入记录器
+ *
+ * @note 写入记录文件失败时不影响读取结果
+ *
+ * @param name 属性名称
+ * @param value 属性值
+ * @param size 属性值长度
+ */
+void HostClient::record(const frozen::string name, const void* value, Size size)
+{
+    if (recorder && recorder->is_open()) recorder->record(name, value, size);
+}
+
+/**
+ * @brief 是否接收来自目标地址的帧
+ *
+ * @note 目标地址为广播地址时接收所有 Server 的应答, 用于地址发现
+ *
+ * @param target 帧头中的地址
+ * @return true 接收
+ * @return false 跳过
+ */
+bool HostClient::accepts(Address target) const
+{
+    return address == ADDRESS_BROADCAST || target == address;
+}
+
+/**
+ * @brief 是否为 Server 主动发送的异步帧
+ *
+ * @param cmd 命令
+ * @return true 异步帧
+ * @return false 响应帧
+ */
+bool HostClient::is_async(Command cmd)
+{
+    return cmd == Command::LOG || cmd == Command::LOG_BATCH || cmd == Command::SCOPE_DATA;
+}
+
+/**
+ * @brief 处理异步帧
+ *
+ * @param cmd 命令
+ * @param extra 附加参数
+ */
+void HostClient::handle_async(Command cmd, Extra& extra)
+{
+    switch (cmd)
+    {
+    case Command::LOG:
+    {
+        uint8_t level;
+        if (!extra.get(level)) break;
+        output(level, extra.curr(), extra.remain());
+        break;
+    }
+    case Command::LOG_BATCH:
+    {
+        uint8_t level, len;
+        while (extra.get(level) && extra.get(len) && len <= extra.remain())
+        {
+            output(level, extra.curr(), len);
+            extra.seek(extra.curr() - extra.data() + len);
+        }
+        break;
+    }
+    case Command::SCOPE_DATA:
+        if (scope) scope->receive(extra);
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief 输出一条日志, 二进制日志根据格式表展开为文本
+ *
+ * @param level 日志等级, 可能带有 LOG_BINARY 标记
+ * @param log 日志内容
+ * @param size 日志长度
+ */
+void HostClient::output(uint8_t level, const uint8_t* log, size_t size)
+{
+    if (!(level & LOG_BINARY) || !formats)
+    {
+        log_output((LogLevel)level, log, size);
+        return;
+    }
+
+    std::array<char, 512> text;
+    size_t                len = formats->expand(log, size, text.data(), text.size());
+    log_output((LogLevel)(level & ~LOG_BINARY), (const uint8_t*)text.data(), len);
+}
+
+/**
+ * @brief 获取 Server 的通信能力
+ *
+ * @note 旧版本的 Server 不支持此命令, 此时保留本机的默认值
+ *
+ * @return ErrorCode 错误码
+ */
+ErrorCode HostClient::negotiate()
+{
+    ErrorCode err;
+    extra.reset();
+    // 发送请求
+    send(Command::GET_CAPABILITY, extra, false);
+    // 接收响应
+    if (!recv_response(Command::GET_CAPABILITY, err, extra)) return ErrorCode::E_TIMEOUT;
+    if (err != ErrorCode::S_OK) return err;
+
+    Capability cap;
+    if (!extra.get(cap)) return ErrorCode::E_FAIL;
+    // 检查参数是否合理
+    if (cap.memory == 0 || cap.memory > cap.capacity) return ErrorCode::E_INVALID_ARG;
+    capability = cap;
+    return ErrorCode::S_OK;
+}
+
+/**
+ * @brief 内存属性单次访问的最大长度
+ *
+ * @return Size 双方均支持的最大长度
+ */
+Size HostClient::memory_access_size() const
+{
+    return std::min<Size>(MEMORY_ACCESS_SIZE_MAX, capability.memory);
+}
+
+/**
+ * @brief 设置链路参数, Server 应答后双方同时切换
+ *
+ * @note 链路参数作用于 Client 收发的所有帧, 多点总线上所有设备必须一致:
+ * 此时应将 address 设为广播地址, 所有设备同时切换, 不等待应答
+ * @note 加密套件以当前套件加密发送, 各设备的随机数不同, 因此只能单播设置
+ *
+ * @param option 链路参数
+ * @param value 参数值
+ * @return ErrorCode 错误码
+ */
+ErrorCode HostClient::set_link(LinkOption option, uint8_t value)
+{
+    ErrorCode err;
+    bool      encrypt = option == LinkOption::CIPHER;
+    if ((err = check_link(option, value)) != ErrorCode::S_OK) return err;
+    if (encrypt && address == ADDRESS_BROADCAST) return ErrorCode::E_INVALID_ARG;
+
+    extra.reset();
+    extra.add(option);
+    extra.add(value);
+    // 发送请求
+    send(Command::SET_LINK, extra, encrypt);
+    if (address == ADDRESS_BROADCAST)
+    {
+        apply_link(option, value);
+        return ErrorCode::S_OK;
+    }
+    // 接收响应
+    if (!recv_response(Command::SET_LINK, err, extra)) return ErrorCode::E_TIMEOUT;
+    if (err != ErrorCode::S_OK) return err;
+    apply_link(option, value);
+    return ErrorCode::S_OK;
+}
+
+/**
+ * @brief 将链路参数恢复为默认值
+ *
+ * @note 请求不带附加参数, 不受当前校验和类型的影响, 可用于恢复失步的链路
+ *
+ * @return ErrorCode 错误码
+ */
+ErrorCode HostClient::reset_link()
+{
+    ErrorCode err;
+    default_link();
+    extra.reset();
+    // 发送请求
+    send(Command::SET_LINK, extra, false);
+    if (address == ADDRESS_BROADCAST) return ErrorCode::S_OK;
+    // 接收响应
+    if (!recv_response(Command::SET_LINK, err, extra)) return ErrorCode::E_TIMEOUT;
+    return err;
+}
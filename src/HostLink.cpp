@@ -0,0 +1,148 @@
+#include "HostLink.hpp"
+
+/**
+ * @brief 从传输层读取可用的字节并解析, 凑齐一帧后停止读取
+ *
+ * @param budget 最多读取的字节数
+ * @return true 已凑齐一帧, 可以调用 poll
+ * @return false 尚未凑齐一帧
+ */
+bool HostLink::pump(size_t budget)
+{
+    while (!_ready && budget > 0)
+    {
+        uint8_t byte;
+        if (!_transport.rx(byte)) break;
+        budget--;
+
+        switch (_state)
+        {
+        case State::HEAD:
+        {
+            if (_sync.full()) _stats.noise++;
+            _sync.push(byte);
+            if (!_sync.verify()) break;
+
+            // 帧头有效, 连同校验和一起暂存
+            _staged = _sync.size();
+            for (size_t i = 0; i < _staged; i++)
+                _stage[i] = _sync[i];
+            Header head = _sync.get();
+
+            // 链路参数由整条总线共用, 其他地址的帧也按本机参数计算长度
+            _remain     = 0;
+            if (head.size > 0)
+            {
+                _remain = head.size + (_checksum == ChecksumType::CRC16 ? sizeof(Checksum) : sizeof(uint32_t));
+                if ((uint8_t)head.cmd & 0x80) _remain += _cipher.tag_size();
+            }
+
+            if (!accepts(head.address))
+            {
+                // 其他地址的帧不交给协议引擎
+                _stats.foreign++;
+                _stats.skipped += _remain;
+                _staged         = 0;
+                _state          = State::SKIP;
+            }
+            else if (head.size > _extra.capacity())
+            {
+                // 超长的帧只交出帧头, 由 HostBase::recv 拒绝, 附加参数在此丢弃
+                _ready = true;
+                _state = State::SKIP;
+            }
+            else if (_remain > 0)
+                _state = State::BODY;
+            else
+                _ready = true;
+            break;
+        }
+        case State::BODY:
+            _stage[_staged++] = byte;
+            if (--_remain == 0)
+            {
+                _ready = true;
+                _state = State::HEAD;
+            }
+            break;
+        case State::SKIP:
+            if (--_remain == 0) _state = State::HEAD;
+            break;
+        }
+
+        // 丢弃长度为 0 时立即回到帧同步
+        if (_state == State::SKIP && _remain == 0) _state = State::HEAD;
+    }
+    return _ready;
+}
+
+/**
+ * @brief 是否已凑齐一帧
+ *
+ * @return true 可以调用 poll
+ */
+bool HostLink::ready() const
+{
+    return _ready;
+}
+
+/**
+ * @brief 处理已凑齐的一帧
+ *
+ * @note 没有凑齐一帧时只发送缓冲的日志和采样数据
+ *
+ * @return true 成功处理一帧
+ * @return false 没有凑齐一帧/帧无效
+ */
+bool HostLink::poll()
+{
+    if (!_ready)
+    {
+        flush_log();
+        flush_scope();
+        return false;
+    }
+
+    bool ok = HostServer::poll();
+    _ready  = false;
+    _staged = _pos = 0;
+    return ok;
+}
+
+bool HostLink::rx(uint8_t& byte)
+{
+    if (_pos >= _staged) return false;
+    byte = _stage[_pos++];
+    return true;
+}
+
+void HostLink::tx(const void* buf, size_t size)
+{
+    _transport.tx(buf, size);
+}
+
+bool HostLink::skip(size_t)
+{
+    // 附加参数由 pump 在 SKIP 状态丢弃
+    return true;
+}
+
+/**
+ * @brief 轮询所有端点一遍
+ *
+ * @param budget 每个端点最多读取的字节数
+ * @return size_t 本轮处理的帧数
+ */
+size_t HostLinks::poll(size_t budget)
+{
+    size_t frames = 0;
+    for (size_t i = 0; i < _size; i++)
+    {
+        HostLink& link = *_links[(_next + i) % _size];
+        // 空闲的端点在 poll 中仍会发送缓冲的日志和采样数据
+        if (link.pump(budget)) frames++;
+        link.poll();
+    }
+    if (_size > 0) _next = (_next + 1) % _size;
+    return frames;
+}
@@ -0,0 +1,171 @@
+#include "HostRouter.hpp"
+#include <algorithm>
+#include <string.h>
+
+/**
+ * @brief 检查路由表, 由 HostServer::set_router 调用
+ *
+ * @note 覆盖广播地址的路由会把广播帧当作单播转发, 覆盖本机地址的路由使本机不可访问
+ *
+ * @param self 路由器在上游的地址
+ * @return ErrorCode 错误码, 路由为空, 上下游地址范围包含广播地址或上游范围包含本机地址时返回 E_INVALID_ARG
+ */
+ErrorCode HostRouterBase::verify(Address self) const
+{
+    for (size_t i = 0; i < _size; i++)
+    {
+        const Route& route = _routes[i].route;
+        if (route.size == 0 || !_routes[i].link) return ErrorCode::E_INVALID_ARG;
+        if (route.first + route.size > ADDRESS_BROADCAST || route.base + route.size > ADDRESS_BROADCAST)
+            return ErrorCode::E_INVALID_ARG;
+        if (route.contains(self)) return ErrorCode::E_INVALID_ARG;
+    }
+    return ErrorCode::S_OK;
+}
+
+/**
+ * @brief 查找上游地址所属的路由
+ *
+ * @param target 上游地址
+ * @return const RouteLink* 路由, 不属于任何路由时为空
+ */
+const RouteLink* HostRouterBase::find(Address target) const
+{
+    for (size_t i = 0; i < _size; i++)
+    {
+        if (_routes[i].route.contains(target)) return &_routes[i];
+    }
+    return nullptr;
+}
+
+/**
+ * @brief 将一帧放入转发队列, 由 HostServer::poll 调用
+ *
+ * @note 加密帧连同 Tag 原样转发, 不在路由器解密
+ *
+ * @param target 上游地址
+ * @param cmd 命令
+ * @param extra 附加参数
+ * @param err 错误码
+ * @return true 成功
+ * @return false 队列已满
+ */
+bool HostRouterBase::push(Address target, Command cmd, Extra& extra, ErrorCode err)
+{
+    uint8_t encrypted = extra.encrypted();
+    Size    size      = extra.size();
+    size_t  need      = sizeof(target) + sizeof(cmd) + sizeof(err) + sizeof(encrypted) + sizeof(size) +
+                        (encrypted ? sizeof(TagType) : 0) + size;
+
+    LockGuard guard(_lock);
+    if (_capacity - _used < need)
+    {
+        _rejected++;
+        return false;
+    }
+    write(&target, sizeof(target));
+    write(&cmd, sizeof(cmd));
+    write(&err, sizeof(err));
+    write(&encrypted, sizeof(encrypted));
+    write(&size, sizeof(size));
+    if (encrypted) write(extra.tag(), sizeof(TagType));
+    write(extra.data(), size);
+    return true;
+}
+
+/**
+ * @brief 转发一帧到下游并将应答转发回上游, 在下游任务中调用
+ *
+ * @note 阻塞直到收到应答或下游链路接收超时
+ *
+ * @param upstream 上游链路, 通常为设置了此路由器的 HostServer
+ * @return true 转发了一帧
+ * @return false 队列为空
+ */
+bool HostRouterBase::pump(HostBase& upstream)
+{
+    Address   target;
+    Command   cmd;
+    ErrorCode err;
+    Extra&    extra = _extra;
+    if (!pop(target, cmd, err, extra)) return false;
+
+    // 广播帧转发到所有下游链路, 不等待应答
+    if (target == ADDRESS_BROADCAST)
+    {
+        for (size_t i = 0; i < _size; i++)
+        {
+            // 多个路由可以共用一条链路
+            bool sent = false;
+            for (size_t k = 0; k < i; k++)
+                sent |= _routes[k].link == _routes[i].link;
+            if (sent) continue;
+            extra.readall();
+            _routes[i].link->send_to(ADDRESS_BROADCAST, cmd, extra, false, err);
+        }
+        return true;
+    }
+
+    const RouteLink* route = find(target);
+    if (!route) return true;
+
+    // 下游链路只接收目标设备的帧
+    HostBase& link = *route->link;
+    Address   down = route->route.downstream(target);
+    link.address   = down;
+    extra.readall();
+    link.send_to(down, cmd, extra, false, err);
+
+    // 转发应答, 之前收到的目标设备的异步帧也一并转发
+    Command r_cmd;
+    while (link.recv(r_cmd, err, extra))
+    {
+        extra.readall();
+        upstream.send_to(target, r_cmd, extra, false, err);
+        if (r_cmd == cmd) return true;
+    }
+
+    // 代替下游设备应答超时
+    _timeouts++;
+    extra.reset();
+    upstream.send_to(target, cmd, extra, false, ErrorCode::E_TIMEOUT);
+    return true;
+}
+
+void HostRouterBase::write(const void* data, size_t size)
+{
+    size_t tail = (_head + _used) % _capacity;
+    size_t part = std::min(size, _capacity - tail);
+    memcpy(&_queue[tail], data, part);
+    memcpy(_queue, (const uint8_t*)data + part, size - part);
+    _used += size;
+}
+
+void HostRouterBase::read(void* data, size_t size)
+{
+    size_t part = std::min(size, _capacity - _head);
+    memcpy(data, &_queue[_head], part);
+    memcpy((uint8_t*)data + part, _queue, size - part);
+    _head  = (_head + size) % _capacity;
+    _used -= size;
+}
+
+bool HostRouterBase::pop(Address& target, Command& cmd, ErrorCode& err, Extra& extra)
+{
+    uint8_t encrypted;
+    Size    size;
+
+    LockGuard guard(_lock);
+    if (_used == 0) return false;
+    read(&target, sizeof(target));
+    read(&cmd, sizeof(cmd));
+    read(&err, sizeof(err));
+    read(&encrypted, sizeof(encrypted));
+    read(&size, sizeof(size));
+    extra.reset();
+    if (encrypted) read(extra.tag(), sizeof(TagType));
+    read(extra.data(), size);
+    extra.size()      = size;
+    extra.encrypted() = encrypted;
+    return true;
+}
@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <array>
 #include <checksum.h>
+#include <string.h>
 
 /**
  * @brief 从机轮询主机请求
@@ -17,14 +18,44 @@ bool HostServer::poll()
     Command   cmd;
     ErrorCode err;
     Extra&    extra = _extra;
+    // 先发送缓冲的日志和采样数据
+    flush_log();
+    flush_scope();
     if (!recv(cmd, err, extra)) return false;
 
+    // 路由地址的帧交给路由器转发, 广播帧同时转发到下游
+    if (_router && _target != address)
+    {
+        if (_router->find(_target)) return _forward(cmd, extra, err);
+        if (_target == ADDRESS_BROADCAST && cmd != Command::DISCOVER && cmd != Command::ASSIGN &&
+            cmd != Command::SET_LINK)
+            _router->push(_target, cmd, extra, err);
+    }
+
+    // 广播/组播帧只执行写入, 事务, 锁存和地址发现, 除地址发现外不应答, 避免总线冲突;
+    // 链路参数由整条总线共用, 只接受广播地址的 SET_LINK, 所有设备同时切换
+    _silent = _target != address;
+    if (_silent && cmd != Command::SET_PROPERTY && cmd != Command::BEGIN && cmd != Command::COMMIT &&
+        cmd != Command::ABORT && cmd != Command::LATCH && cmd != Command::DISCOVER && cmd != Command::ASSIGN &&
+        !(cmd == Command::SET_LINK && _target == ADDRESS_BROADCAST))
+        return false;
+
+    // 各设备的随机数不同, 广播/组播帧无法解密; 在解密前丢弃, 也不更新随机数
+    if (_silent && extra.encrypted()) return false;
+
+    // 超长的请求未被读入缓冲区
+    if (err == ErrorCode::E_OUT_OF_BUFFER)
+    {
+        _reply(cmd, extra, false, err);
+        return false;
+    }
+
     // 检查加密标记
     if ((encrypted = extra.encrypted()))
     {
-        if (!extra.decrypt(secret.nonce, secret.key))
+        if (!extra.decrypt(secret.nonce, secret.key, _cipher))
         {
-            send(cmd, extra, false, ErrorCode::E_INVALID_ARG);
+            _reply(cmd, extra, false, ErrorCode::E_INVALID_ARG);
             return false;
         }
     }
@@ -37,16 +68,44 @@ bool HostServer::poll()
         extra.readall();
         // 将收到的数据再发回去
         err = ErrorCode::S_OK;
-        send(cmd, extra, encrypted, err);
+        _reply(cmd, extra, encrypted, err);
         break;
     }
     case Command::GET_PROPERTY:
     {
         PropertyBase* prop;
         if (!(prop = _acquire_and_verify(cmd, extra, encrypted))) return false;
+        // 不可变属性直接发送预先生成的应答帧
+        if (!encrypted && _checksum == ChecksumType::CRC16)
+        {
+            const uint8_t* frame;
+            size_t         size;
+            if (prop->get_frame(address, frame, size) == ErrorCode::S_OK)
+            {
+                send_frame(frame, size);
+                break;
+            }
+        }
+        // 未加密且属性锁为空锁时直接从属性值所在的内存发送;
+        // 其他属性锁不能在阻塞的发送期间持有(屏蔽中断的锁会屏蔽整帧的发送时间), 先复制到缓冲区
+        err = ErrorCode::E_NO_IMPLEMENT;
+        if (!encrypted && _prop_lock.trivial())
+        {
+            const uint8_t* data;
+            Size           size;
+            if ((err = prop->get_view(extra, encrypted, data, size)) == ErrorCode::S_OK)
+            {
+                send_direct(cmd, data, size, err);
+                break;
+            }
+        }
         // 读取属性值
-        err = prop->get(extra, encrypted);
-        send(cmd, extra, encrypted, err);
+        if (err == ErrorCode::E_NO_IMPLEMENT)
+        {
+            LockGuard guard(_prop_lock);
+            err = prop->get(extra, encrypted);
+        }
+        _reply(cmd, extra, encrypted, err);
         break;
     }
     case Command::SET_PROPERTY:
@@ -54,8 +113,11 @@ bool HostServer::poll()
         PropertyBase* prop;
         if (!(prop = _acquire_and_verify(cmd, extra, encrypted))) return false;
         // 写入属性值
-        err = prop->set(extra, encrypted);
-        send(cmd, extra, encrypted, err);
+        {
+            LockGuard guard(_prop_lock);
+            err = prop->set(extra, encrypted);
+        }
+        _reply(cmd, extra, encrypted, err);
         break;
     }
     case Command::GET_SIZE:
@@ -64,7 +126,7 @@ bool HostServer::poll()
         if (!(prop = _acquire_and_verify(cmd, extra, encrypted))) return false;
         // 读取 Size
         err = prop->get_size(extra, encrypted);
-        send(cmd, extra, encrypted, err);
+        _reply(cmd, extra, encrypted, err);
         break;
     }
     case Command::GET_ACCESS:
@@ -73,12 +135,169 @@ bool HostServer::poll()
         if (!(prop = _acquire_and_verify(cmd, extra, encrypted))) return false;
         // 读取 Access
         err = prop->get_access(extra, encrypted);
-        send(cmd, extra, encrypted, err);
+        _reply(cmd, extra, encrypted, err);
+        break;
+    }
+    case Command::COMMIT:
+    {
+        PropertyBase* prop;
+        if (!(prop = _acquire_and_verify(cmd, extra, encrypted))) return false;
+        // 提交缓存的写入
+        {
+            LockGuard guard(_prop_lock);
+            err = prop->commit(extra, encrypted);
+        }
+        _reply(cmd, extra, encrypted, err);
+        break;
+    }
+    case Command::BEGIN:
+    {
+        PropertyBase* prop;
+        if (!(prop = _acquire_and_verify(cmd, extra, encrypted))) return false;
+        // 开始事务
+        {
+            LockGuard guard(_prop_lock);
+            err = prop->begin(extra, encrypted);
+        }
+        _reply(cmd, extra, encrypted, err);
+        break;
+    }
+    case Command::ABORT:
+    {
+        PropertyBase* prop;
+        if (!(prop = _acquire_and_verify(cmd, extra, encrypted))) return false;
+        // 放弃事务
+        {
+            LockGuard guard(_prop_lock);
+            err = prop->abort(extra, encrypted);
+        }
+        _reply(cmd, extra, encrypted, err);
+        break;
+    }
+    case Command::GET_CRC:
+    {
+        PropertyBase* prop;
+        if (!(prop = _acquire_and_verify(cmd, extra, encrypted))) return false;
+        // 计算校验和
+        {
+            LockGuard guard(_prop_lock);
+            err = prop->get_crc(extra, encrypted);
+        }
+        _reply(cmd, extra, encrypted, err);
+        break;
+    }
+    case Command::SET_LINK:
+    {
+        LinkOption option;
+        uint8_t    value;
+        // 不带附加参数时恢复默认值
+        bool       reset = extra.remain() == 0;
+        if (reset)
+            err = ErrorCode::S_OK;
+        else if (!extra.get(option) || !extra.get(value))
+            err = ErrorCode::E_INVALID_ARG;
+        // 加密套件只能在当前套件加密的请求中修改, 防止总线上的第三方降级
+        else if (option == LinkOption::CIPHER && !encrypted)
+            err = ErrorCode::E_NO_PERMISSION;
+        else
+            err = check_link(option, value);
+        extra.reset();
+        _reply(cmd, extra, encrypted, err);
+        // 应答发送后再切换链路参数
+        if (reset)
+            default_link();
+        else if (err == ErrorCode::S_OK)
+            apply_link(option, value);
+        break;
+    }
+    case Command::SET_SCOPE:
+    {
+        uint16_t divider;
+        if (!_scope)
+            err = ErrorCode::E_NO_IMPLEMENT;
+        else if (!extra.get(divider))
+            err = ErrorCode::E_INVALID_ARG;
+        else
+            err = _configure_scope(divider, extra);
+        // 应答各通道采样值的长度
+        extra.reset();
+        if (err == ErrorCode::S_OK)
+        {
+            for (size_t i = 0; i < _scope->channels(); i++)
+                extra.add<uint8_t>(_scope->width(i));
+        }
+        _reply(cmd, extra, encrypted, err);
+        break;
+    }
+    case Command::LATCH:
+    {
+        uint16_t seq;
+        if (!_latch)
+            err = ErrorCode::E_NO_IMPLEMENT;
+        else if (!extra.get(seq))
+            err = ErrorCode::E_INVALID_ARG;
+        else
+        {
+            // 所有通道在同一次加锁中锁存
+            LockGuard guard(_prop_lock);
+            _latch->trigger(seq);
+            err = ErrorCode::S_OK;
+        }
+        extra.reset();
+        _reply(cmd, extra, encrypted, err);
+        break;
+    }
+    case Command::DISCOVER:
+    {
+        // 其他设备的应答也可能被当作请求收到, 只接受长度一致的请求
+        if (!_uid) return false;
+        if (extra.remain() == 0)
+        {
+            _assigned = false;
+            return true;
+        }
+        DiscoverRequest req;
+        if (extra.remain() != sizeof(req) || !extra.get(req)) return false;
+        if (_assigned || !req.match(*_uid)) return false;
+        // 各设备在不同的时隙应答, 减少冲突
+        wait_slot(req.slot(*_uid), req.width);
+        extra.reset();
+        extra.add(*_uid);
+        err = ErrorCode::S_OK;
+        send(cmd, extra, false, err);
+        break;
+    }
+    case Command::ASSIGN:
+    {
+        UniqueId uid;
+        Address  target;
+        if (!_uid) return false;
+        if (extra.remain() != sizeof(uid) + sizeof(target) || !extra.get(uid) || !extra.get(target)) return false;
+        if (uid != *_uid || target == ADDRESS_BROADCAST) return false;
+        // 以新地址应答, Client 据此确认分配成功
+        address   = target;
+        _assigned = true;
+        extra.reset();
+        extra.add(uid);
+        err = ErrorCode::S_OK;
+        send(cmd, extra, false, err);
+        break;
+    }
+    case Command::GET_CAPABILITY:
+    {
+        Capability cap;
+        cap.capacity = extra.capacity();
+        cap.memory   = extra.capacity() - sizeof(PropertyId) - sizeof(MemoryAccess);
+        cap.features = features();
+        extra.reset();
+        extra.add(cap);
+        err = ErrorCode::S_OK;
+        _reply(cmd, extra, encrypted, err);
         break;
     }
     default:
         err = ErrorCode::E_NO_IMPLEMENT;
-        send(cmd, extra, encrypted, err);
+        _reply(cmd, extra, encrypted, err);
         break;
     }
 
@@ -99,8 +318,210 @@ void HostServer::log(const void* log, size_t size)
     head.address = address;
     head.cmd     = Command::LOG;
     head.error   = ErrorCode::S_OK;
-    head.size    = size;
-    send(head, log, size);
+    // 超出帧长限制的部分被截断
+    head.size    = std::min<size_t>(size, UINT16_MAX);
+    send(head, log, head.size);
+}
+
+/**
+ * @brief 发送 Server 日志
+ *
+ * @note 设置了日志缓冲区时只写入缓冲区, 由 poll 批量发送, 可以在中断中调用
+ * @note 未设置日志缓冲区时立即以 LOG 命令发送
+ *
+ * @param level 日志等级
+ * @param log 日志数据
+ * @param size 日志数据字节长度
+ */
+void HostServer::log(LogLevel level, const void* log, size_t size)
+{
+    if (_log)
+    {
+        _log->push(level, log, size);
+        return;
+    }
+
+    // 与缓冲的日志长度限制保持一致
+    std::array<uint8_t, 1 + LogBufferBase::RECORD_MAX> buf;
+    size   = std::min(size, LogBufferBase::RECORD_MAX);
+    buf[0] = (uint8_t)level;
+    memcpy(&buf[1], log, size);
+    this->log(buf.data(), 1 + size);
+}
+
+/**
+ * @brief 将日志缓冲区中的日志打包为一帧发送
+ *
+ * @note 与 poll 共用附加参数缓冲区, 只能在调用 poll 的任务中调用, 可用作空闲钩子
+ *
+ * @return true 仍有待发送的日志
+ * @return false 日志已全部发送
+ */
+bool HostServer::flush_log()
+{
+    if (!_log || _log->empty()) return false;
+
+    Extra& extra = _extra;
+    extra.reset();
+    size_t size = _log->pop(extra.data(), extra.capacity());
+    extra.seek(size);
+    send(Command::LOG_BATCH, extra);
+    return !_log->empty();
+}
+
+/**
+ * @brief 设置日志缓冲区
+ *
+ * @param buffer 日志缓冲区, 为空时日志立即发送
+ */
+void HostServer::set_log_buffer(LogBufferBase* buffer)
+{
+    _log = buffer;
+}
+
+/**
+ * @brief 发送一块采样数据
+ *
+ * @note 可以在 poll 之外的任务中调用, 但不能与 SET_SCOPE 的处理同时进行
+ *
+ * @return true 发送了一块
+ * @return false 没有待发送的块
+ */
+bool HostServer::flush_scope()
+{
+    const uint8_t* data;
+    Size           size;
+    if (!_scope || !_scope->acquire(data, size)) return false;
+    send_direct(Command::SCOPE_DATA, data, size);
+    _scope->release();
+    return true;
+}
+
+/**
+ * @brief 设置示波器模式的采样器
+ *
+ * @param scope 采样器, 为空时不支持示波器模式
+ */
+void HostServer::set_scope(ScopeBase* scope)
+{
+    _scope = scope;
+}
+
+/**
+ * @brief 获取 Server 支持的功能
+ *
+ * @return uint32_t 功能标记, 见 Feature
+ */
+uint32_t HostServer::features() const
+{
+    uint32_t features = (uint32_t)Feature::ENCRYPT | (uint32_t)Feature::TRANSACTION | (uint32_t)Feature::CRC |
+                        (uint32_t)Feature::CRC32C | (uint32_t)Feature::CIPHER;
+    if (_scope) features |= (uint32_t)Feature::SCOPE;
+    if (_latch) features |= (uint32_t)Feature::LATCH;
+    if (_uid) features |= (uint32_t)Feature::DISCOVER;
+    if (_router) features |= (uint32_t)Feature::ROUTER;
+    return features;
+}
+
+/**
+ * @brief 设置锁存器
+ *
+ * @note 锁存器通常同时放入属性值容器, 以便 Client 读取锁存值
+ *
+ * @param latch 锁存器, 为空时不支持 LATCH
+ */
+void HostServer::set_latch(LatchBase* latch)
+{
+    _latch = latch;
+}
+
+/**
+ * @brief 设置唯一Id
+ *
+ * @note 唯一Id应当在设备间不同, 通常使用 MCU 的唯一Id
+ *
+ * @param uid 唯一Id, 为空时不支持地址发现
+ */
+void HostServer::set_uid(const UniqueId* uid)
+{
+    _uid = uid;
+}
+
+void HostServer::wait_slot(uint8_t, uint16_t)
+{
+}
+
+/**
+ * @brief 设置路由器
+ *
+ * @note 路由器的 pump 通常在下游任务中调用
+ *
+ * @param router 路由器, 为空时不转发
+ * @return ErrorCode 错误码, 路由表无效时返回 E_INVALID_ARG 且保持原路由器, 见 HostRouterBase::verify
+ */
+ErrorCode HostServer::set_router(HostRouterBase* router)
+{
+    ErrorCode err;
+    if (router && (err = router->verify(address)) != ErrorCode::S_OK) return err;
+    _router = router;
+    return ErrorCode::S_OK;
+}
+
+/**
+ * @brief 设置组播地址
+ *
+ * @note 组播地址通常由属性保存, 以便 Client 配置; 广播地址始终接收
+ *
+ * @param groups 组播地址数组, 为空时不接收组播
+ * @param size 组播地址个数
+ */
+void HostServer::set_groups(const Address* groups, size_t size)
+{
+    _groups      = groups;
+    _groups_size = size;
+}
+
+bool HostServer::accepts(Address target) const
+{
+    if (target == address || target == ADDRESS_BROADCAST) return true;
+    if (_router && _router->find(target)) return true;
+    for (size_t i = 0; i < _groups_size; i++)
+    {
+        if (_groups[i] == target) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief 发送应答, 广播/组播帧不应答
+ *
+ */
+void HostServer::_reply(Command cmd, Extra& extra, bool encrypted, ErrorCode err)
+{
+    if (_silent) return;
+    send(cmd, extra, encrypted, err);
+}
+
+/**
+ * @brief 将路由地址的帧放入转发队列, 无法转发时代替下游设备应答
+ *
+ * @return true 已放入转发队列
+ * @return false 无法转发
+ */
+bool HostServer::_forward(Command cmd, Extra& extra, ErrorCode err)
+{
+    // 超长的帧未被读入缓冲区; 链路参数只作用于单段链路
+    if (err == ErrorCode::E_OUT_OF_BUFFER)
+        ;
+    else if (cmd == Command::SET_LINK)
+        err = ErrorCode::E_NO_IMPLEMENT;
+    else if (_router->push(_target, cmd, extra, err))
+        return true;
+    else
+        err = ErrorCode::E_OUT_OF_BUFFER;
+    extra.reset();
+    send_to(_target, cmd, extra, false, err);
+    return false;
 }
 
 PropertyBase* HostServer::_acquire_and_verify(Command cmd, Extra& extra, bool encrypted)
@@ -109,25 +530,29 @@ PropertyBase* HostServer::_acquire_and_verify(Command cmd, Extra& extra, bool en
     PropertyId id;
     if (!extra.get(id))
     {
-        send(cmd, extra, encrypted, ErrorCode::E_INVALID_ARG);
+        _reply(cmd, extra, encrypted, ErrorCode::E_INVALID_ARG);
         return nullptr;
     }
     // 查找属性值
     PropertyBase* prop;
     if (!(prop = _holder.get(id)))
     {
-        send(cmd, extra, encrypted, ErrorCode::E_ID_NOT_EXIST);
+        _reply(cmd, extra, encrypted, ErrorCode::E_ID_NOT_EXIST);
         return nullptr;
     }
     // 检查权限
     ErrorCode err;
     switch (cmd)
     {
+    case Command::GET_CRC:
     case Command::GET_SIZE:
     case Command::GET_ACCESS:
     case Command::GET_PROPERTY:
         err = prop->check_read(encrypted);
         break;
+    case Command::BEGIN:
+    case Command::ABORT:
+    case Command::COMMIT:
     case Command::SET_PROPERTY:
         err = prop->check_write(encrypted);
         break;
@@ -137,8 +562,31 @@ PropertyBase* HostServer::_acquire_and_verify(Command cmd, Extra& extra, bool en
     }
     if (err != ErrorCode::S_OK)
     {
-        send(cmd, extra, encrypted, err);
+        _reply(cmd, extra, encrypted, err);
         return nullptr;
     }
     return prop;
 }
+
+ErrorCode HostServer::_configure_scope(uint16_t divider, Extra& extra)
+{
+    _scope->stop();
+
+    PropertyId id;
+    ErrorCode  err = ErrorCode::S_OK;
+    while (err == ErrorCode::S_OK && extra.get(id))
+    {
+        PropertyBase* prop;
+        if (!(prop = _holder.get(id)))
+            err = ErrorCode::E_ID_NOT_EXIST;
+        // 采样数据不加密, 受保护的属性不能采样
+        else if ((err = prop->check_read(false)) == ErrorCode::S_OK)
+            err = _scope->add(prop);
+    }
+    // 配置失败时保持停止状态
+    if (err != ErrorCode::S_OK)
+        _scope->stop();
+    else
+        _scope->start(divider);
+    return err;
+}
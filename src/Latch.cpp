@@ -0,0 +1,71 @@
+#include "Latch.hpp"
+#include <string.h>
+
+/**
+ * @brief 清空通道
+ *
+ */
+void LatchBase::clear()
+{
+    _count = 0;
+    _row   = 0;
+}
+
+/**
+ * @brief 添加一个锁存通道
+ *
+ * @param prop 锁存的属性, 需要支持 sample
+ * @return ErrorCode 错误码, 受保护的属性返回 E_NO_PERMISSION
+ */
+ErrorCode LatchBase::add(const PropertyBase* prop)
+{
+    ErrorCode err;
+    if (_count >= _channels_max) return ErrorCode::E_OUT_OF_INDEX;
+    // 锁存器本身不加密读取, 受保护的属性不能锁存
+    if ((err = prop->check_read(false)) != ErrorCode::S_OK) return err;
+
+    Size width = prop->sample(nullptr);
+    // 不支持采样的属性
+    if (width == 0) return ErrorCode::E_INVALID_ARG;
+    if (_row + width > _shadow_size) return ErrorCode::E_OUT_OF_BUFFER;
+
+    _props[_count] = prop;
+    _count++;
+    _row += width;
+    return ErrorCode::S_OK;
+}
+
+/**
+ * @brief 锁存所有通道的当前值, 由 HostServer 在持有属性锁时调用
+ *
+ * @param seq 序号
+ */
+void LatchBase::trigger(uint16_t seq)
+{
+    uint8_t* row = _shadow;
+    memcpy(row, &seq, sizeof(seq));
+    row += sizeof(seq);
+    for (size_t i = 0; i < _count; i++)
+        row += _props[i]->sample(row);
+}
+
+ErrorCode LatchBase::get(Extra& extra, bool) const
+{
+    extra.reset();
+    if (!extra.add(_shadow, sizeof(uint16_t) + _row)) return ErrorCode::E_OUT_OF_BUFFER;
+    return ErrorCode::S_OK;
+}
+
+ErrorCode LatchBase::get_view(Extra&, bool, const uint8_t*& data, Size& size) const
+{
+    data = _shadow;
+    size = sizeof(uint16_t) + _row;
+    return ErrorCode::S_OK;
+}
+
+ErrorCode LatchBase::get_size(Extra& extra, bool) const
+{
+    extra.reset();
+    extra.add<Size>(sizeof(uint16_t) + _row);
+    return ErrorCode::S_OK;
+}
@@ -0,0 +1,123 @@
+#include "LogBuffer.hpp"
+#include <algorithm>
+#include <string.h>
+
+/**
+ * @brief 写入一条日志
+ *
+ * @param level 日志等级
+ * @param data 日志内容
+ * @param size 日志长度
+ * @return true 写入成功
+ * @return false 被过滤或缓冲区满
+ */
+bool LogBufferBase::push(LogLevel level, const void* data, size_t size)
+{
+    // 过滤在加锁前完成, 被过滤的日志几乎没有开销
+    if ((LogLevel)((uint8_t)level & ~LOG_BINARY) < config.level) return false;
+
+    uint8_t len  = std::min(size, RECORD_MAX);
+    size_t  need = 2 + len;
+
+    LockGuard guard(_lock);
+    while (_capacity - _used < need)
+    {
+        _dropped = _dropped + 1;
+        if (config.overflow == LogOverflow::DROP_NEW) return false;
+        drop_oldest();
+    }
+
+    size_t tail = (_head + _used) % _capacity;
+    write(tail, &level, 1);
+    write(tail + 1, &len, 1);
+    write(tail + 2, data, len);
+    _used = _used + need;
+    return true;
+}
+
+/**
+ * @brief 取出尽可能多的完整日志
+ *
+ * @param buf 接收日志的缓冲区
+ * @param capacity 缓冲区长度
+ * @return size_t 取出的字节数
+ */
+size_t LogBufferBase::pop(uint8_t* buf, size_t capacity)
+{
+    LockGuard guard(_lock);
+    size_t    count = 0;
+    while (count < _used)
+    {
+        uint8_t len;
+        read(_head + count + 1, &len, 1);
+        // 只取出完整的日志
+        if (count + 2 + len > capacity) break;
+        read(_head + count, buf + count, 2 + len);
+        count += 2 + len;
+    }
+    _head = (_head + count) % _capacity;
+    _used = _used - count;
+    return count;
+}
+
+/**
+ * @brief 缓冲区是否为空
+ *
+ * @return true 没有待发送的日志
+ * @return false 有待发送的日志
+ */
+bool LogBufferBase::empty() const
+{
+    return _used == 0;
+}
+
+/**
+ * @brief 获取因缓冲区满而丢弃的日志条数
+ *
+ * @return uint32_t 丢弃的日志条数
+ */
+uint32_t LogBufferBase::dropped() const
+{
+    return _dropped;
+}
+
+/**
+ * @brief 写入存储区, 自动处理回绕
+ *
+ * @param pos 相对存储区起始的位置
+ * @param data 要写入的数据
+ * @param size 数据长度
+ */
+void LogBufferBase::write(size_t pos, const void* data, size_t size)
+{
+    pos        = pos % _capacity;
+    size_t len = std::min(size, _capacity - pos);
+    memcpy(&_data[pos], data, len);
+    memcpy(&_data[0], (const uint8_t*)data + len, size - len);
+}
+
+/**
+ * @brief 读取存储区, 自动处理回绕
+ *
+ * @param pos 相对存储区起始的位置
+ * @param data 接收数据的缓冲区
+ * @param size 数据长度
+ */
+void LogBufferBase::read(size_t pos, void* data, size_t size) const
+{
+    pos        = pos % _capacity;
+    size_t len = std::min(size, _capacity - pos);
+    memcpy(data, &_data[pos], len);
+    memcpy((uint8_t*)data + len, &_data[0], size - len);
+}
+
+/**
+ * @brief 丢弃最早的一条日志
+ */
+void LogBufferBase::drop_oldest()
+{
+    uint8_t len;
+    read(_head + 1, &len, 1);
+    _head = (_head + 2 + len) % _capacity;
+    _used = _used - (2 + len);
+}
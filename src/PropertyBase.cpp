@@ -10,7 +10,42 @@ ErrorCode PropertyBase::get(Extra&, bool) const
     return ErrorCode::E_NO_IMPLEMENT;
 }
 
+ErrorCode PropertyBase::get_view(Extra&, bool, const uint8_t*&, Size&) const
+{
+    return ErrorCode::E_NO_IMPLEMENT;
+}
+
+ErrorCode PropertyBase::get_frame(Address, const uint8_t*&, size_t&) const
+{
+    return ErrorCode::E_NO_IMPLEMENT;
+}
+
 ErrorCode PropertyBase::get_size(Extra&, bool) const
 {
     return ErrorCode::E_NO_IMPLEMENT;
 }
+
+ErrorCode PropertyBase::commit(Extra&, bool)
+{
+    return ErrorCode::E_NO_IMPLEMENT;
+}
+
+ErrorCode PropertyBase::begin(Extra&, bool)
+{
+    return ErrorCode::E_NO_IMPLEMENT;
+}
+
+ErrorCode PropertyBase::abort(Extra&, bool)
+{
+    return ErrorCode::E_NO_IMPLEMENT;
+}
+
+Size PropertyBase::sample(uint8_t*) const
+{
+    return 0;
+}
+
+ErrorCode PropertyBase::get_crc(Extra&, bool) const
+{
+    return ErrorCode::E_NO_IMPLEMENT;
+}
@@ -0,0 +1,134 @@
+#include "Scope.hpp"
+#include <string.h>
+
+/**
+ * @brief 停止采样并清空通道
+ *
+ */
+void ScopeBase::stop()
+{
+    LockGuard guard(_lock);
+    _running = false;
+    _count   = 0;
+    _row     = 0;
+    _fill    = 0;
+    _pending = false;
+}
+
+/**
+ * @brief 添加一个采样通道, 需要在停止采样时调用
+ *
+ * @param prop 采样的属性
+ * @return ErrorCode 错误码
+ */
+ErrorCode ScopeBase::add(const PropertyBase* prop)
+{
+    LockGuard guard(_lock);
+    if (_running) return ErrorCode::E_ILLEGAL_STATE;
+    if (_count >= _channels_max) return ErrorCode::E_OUT_OF_INDEX;
+
+    Size width = prop->sample(nullptr);
+    // 不支持采样的属性
+    if (width == 0 || width > SCOPE_WIDTH_MAX) return ErrorCode::E_INVALID_ARG;
+
+    _props[_count]  = prop;
+    _widths[_count] = width;
+    _count++;
+    _row += width;
+    return ErrorCode::S_OK;
+}
+
+/**
+ * @brief 开始采样
+ *
+ * @param divider 分频系数, 每 divider 次 tick 采样一次
+ */
+void ScopeBase::start(uint16_t divider)
+{
+    LockGuard guard(_lock);
+    if (_count == 0) return;
+    _divider = divider == 0 ? 1 : divider;
+    _phase   = 0;
+    _active  = 0;
+    _fill    = 0;
+    _pending = false;
+    _running = true;
+}
+
+/**
+ * @brief 采样钩子, 在定时器中断中调用
+ *
+ */
+void ScopeBase::tick()
+{
+    LockGuard guard(_lock);
+    if (!_running) return;
+    if (++_phase < _divider) return;
+    _phase = 0;
+
+    // 当前块已满且另一块未发送完
+    if (_fill + _row > _block_size && !swap())
+    {
+        _overrun = _overrun + 1;
+        return;
+    }
+
+    uint8_t* row = block(_active) + sizeof(uint16_t) + _fill;
+    for (size_t i = 0; i < _count; i++)
+        row += _props[i]->sample(row);
+    _fill += _row;
+
+    // 写满后立即交换, 尽快发送
+    if (_fill + _row > _block_size) swap();
+}
+
+/**
+ * @brief 获取待发送的块
+ *
+ * @note 发送完成后需要调用 release
+ *
+ * @param data [out]块的首地址
+ * @param size [out]块的长度
+ * @return true 有待发送的块
+ * @return false 没有待发送的块
+ */
+bool ScopeBase::acquire(const uint8_t*& data, Size& size)
+{
+    LockGuard guard(_lock);
+    // 上一块发送期间当前块已写满
+    if (!_pending && _running && _fill + _row > _block_size) swap();
+    if (!_pending) return false;
+    data = block(_active ^ 1);
+    size = _ready;
+    return true;
+}
+
+/**
+ * @brief 释放已发送的块
+ *
+ */
+void ScopeBase::release()
+{
+    LockGuard guard(_lock);
+    _pending = false;
+}
+
+/**
+ * @brief 交换当前块与待发送的块
+ *
+ * @return true 交换成功
+ * @return false 另一块尚未发送完
+ */
+bool ScopeBase::swap()
+{
+    if (_pending) return false;
+
+    uint8_t* curr = block(_active);
+    memcpy(curr, &_seq, sizeof(_seq));
+    _seq++;
+    _ready   = sizeof(uint16_t) + _fill;
+    _pending = true;
+    _active ^= 1;
+    _fill    = 0;
+    return true;
+}
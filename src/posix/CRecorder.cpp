@@ -0,0 +1,196 @@
+#include "CRecorder.hpp"
+#include <chrono>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+CRecorderBase::~CRecorderBase()
+{
+    close();
+}
+
+/**
+ * @brief 打开记录文件, 文件已存在时在末尾追加新的会话
+ *
+ * @param path 文件路径
+ * @return ErrorCode 错误码
+ */
+ErrorCode CRecorderBase::open(const char* path)
+{
+    ErrorCode err;
+    if ((err = close()) != ErrorCode::S_OK) return err;
+
+    _fd = ::open(path, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (_fd < 0) return ErrorCode::E_FAIL;
+
+    // 新会话重新登记通道
+    _count = 0;
+    return append(RecordKind::SESSION, 0, 0, nullptr, 0, nullptr, 0);
+}
+
+/**
+ * @brief 写入缓存的采样点并关闭记录文件
+ *
+ * @return ErrorCode 错误码
+ */
+ErrorCode CRecorderBase::close()
+{
+    if (_fd < 0) return ErrorCode::S_OK;
+
+    ErrorCode err = flush();
+    if (::close(_fd) != 0 && err == ErrorCode::S_OK) err = ErrorCode::E_FAIL;
+    _fd    = -1;
+    _count = 0;
+    return err;
+}
+
+/**
+ * @brief 将所有通道缓存的采样点写入记录文件
+ *
+ * @return ErrorCode 错误码
+ */
+ErrorCode CRecorderBase::flush()
+{
+    ErrorCode err = ErrorCode::S_OK;
+    for (size_t i = 0; i < _count; i++)
+    {
+        ErrorCode ret = flush(i);
+        if (err == ErrorCode::S_OK) err = ret;
+    }
+    return err;
+}
+
+/**
+ * @brief 以当前时间记录一个属性值
+ *
+ * @param name 属性名称
+ * @param value 属性值
+ * @param size 属性值长度
+ * @return ErrorCode 错误码
+ */
+ErrorCode CRecorderBase::record(const frozen::string name, const void* value, Size size)
+{
+    return record(name, now(), value, size);
+}
+
+/**
+ * @brief 记录一个属性值
+ *
+ * @note 同一通道的时间戳应当单调不减, Replay 按时间戳二分查找
+ *
+ * @param name 属性名称
+ * @param time 时间戳
+ * @param value 属性值
+ * @param size 属性值长度
+ * @return ErrorCode 错误码
+ */
+ErrorCode CRecorderBase::record(const frozen::string name, uint64_t time, const void* value, Size size)
+{
+    if (_fd < 0) return ErrorCode::E_ILLEGAL_STATE;
+    if (size == 0 || size > _width_max) return ErrorCode::E_INVALID_ARG;
+
+    std::string_view key(name.data(), name.size());
+    size_t           ch = 0;
+    while (ch < _count && _names[ch] != key)
+        ch++;
+
+    if (ch == _count)
+    {
+        // 登记新通道
+        if (_count >= _channels_max) return ErrorCode::E_OUT_OF_INDEX;
+        if (key.size() > UINT32_MAX) return ErrorCode::E_INVALID_ARG;
+        _names[ch]  = key;
+        _widths[ch] = size;
+        _fills[ch]  = 0;
+        _count++;
+        ErrorCode err = append(RecordKind::CHANNEL, ch, key.size(), key.data(), key.size(), nullptr, 0);
+        if (err != ErrorCode::S_OK) return err;
+    }
+    else if (_widths[ch] != size)
+        return ErrorCode::E_INVALID_ARG;
+
+    size_t fill                    = _fills[ch];
+    _times[ch * _depth_max + fill] = time;
+    memcpy(&_values[(ch * _depth_max + fill) * _width_max], value, size);
+    _fills[ch] = fill + 1;
+
+    if (_fills[ch] >= _depth_max) return flush(ch);
+    return ErrorCode::S_OK;
+}
+
+/**
+ * @brief 获取时间戳, 默认为单调时钟的纳秒数
+ *
+ * @return uint64_t 时间戳
+ */
+uint64_t CRecorderBase::now() const
+{
+    auto time = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time).count();
+}
+
+/**
+ * @brief 将一个通道缓存的采样点写入记录文件
+ *
+ * @param channel 通道
+ * @return ErrorCode 错误码
+ */
+ErrorCode CRecorderBase::flush(size_t channel)
+{
+    size_t count = _fills[channel];
+    if (count == 0) return ErrorCode::S_OK;
+    _fills[channel] = 0;
+
+    // 采样值列在缓存中按最大长度存放, 写入前压缩为实际长度
+    size_t   width  = _widths[channel];
+    uint8_t* values = &_values[channel * _depth_max * _width_max];
+    if (width != _width_max)
+    {
+        for (size_t i = 1; i < count; i++)
+            memmove(&values[i * width], &values[i * _width_max], width);
+    }
+
+    return append(RecordKind::DATA, channel, count, &_times[channel * _depth_max], count * sizeof(uint64_t), values,
+                  count * width);
+}
+
+/**
+ * @brief 在记录文件末尾追加一个块
+ *
+ * @param kind 块类型
+ * @param channel 通道
+ * @param count 名称长度或采样点数
+ * @param head 块数据的第一部分
+ * @param head_size 第一部分的长度
+ * @param tail 块数据的第二部分
+ * @param tail_size 第二部分的长度
+ * @return ErrorCode 错误码
+ */
+ErrorCode CRecorderBase::append(RecordKind kind, size_t channel, size_t count, const void* head, size_t head_size,
+                                const void* tail, size_t tail_size)
+{
+    static const uint8_t padding[RECORD_ALIGN] = {};
+
+    size_t      size  = head_size + tail_size;
+    size_t      pad   = (RECORD_ALIGN - size % RECORD_ALIGN) % RECORD_ALIGN;
+    RecordChunk chunk = {
+        .magic   = RECORD_MAGIC,
+        .kind    = kind,
+        .width   = kind == RecordKind::SESSION ? (uint8_t)0 : _widths[channel],
+        .channel = (uint16_t)channel,
+        .count   = (uint32_t)count,
+        .size    = (uint32_t)(size + pad),
+    };
+
+    // 整块一次写入, 中断时只会在文件末尾留下不完整的块
+    struct iovec iov[] = {
+        {(void*)&chunk,  sizeof(chunk)},
+        {(void*)head,    head_size    },
+        {(void*)tail,    tail_size    },
+        {(void*)padding, pad          },
+    };
+    size_t total = sizeof(chunk) + size + pad;
+    if (::writev(_fd, iov, 4) != (ssize_t)total) return ErrorCode::E_FAIL;
+    return ErrorCode::S_OK;
+}
@@ -0,0 +1,283 @@
+#include "Replay.hpp"
+#include <algorithm>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+Replay::~Replay()
+{
+    close();
+}
+
+/**
+ * @brief 映射记录文件并建立索引
+ *
+ * @param path 文件路径
+ * @return ErrorCode 错误码
+ */
+ErrorCode Replay::open(const char* path)
+{
+    close();
+
+    int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return ErrorCode::E_FAIL;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        ::close(fd);
+        return ErrorCode::E_FAIL;
+    }
+    _size = st.st_size;
+    if (_size > 0)
+    {
+        void* map = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map == MAP_FAILED)
+        {
+            ::close(fd);
+            _size = 0;
+            return ErrorCode::E_FAIL;
+        }
+        _map = (const uint8_t*)map;
+    }
+    ::close(fd);
+
+    // 当前会话的通道号到合并后通道的映射
+    std::vector<size_t> local;
+    for (size_t pos = 0; pos + sizeof(RecordChunk) <= _size;)
+    {
+        RecordChunk chunk;
+        memcpy(&chunk, &_map[pos], sizeof(chunk));
+        // 文件末尾不完整的块
+        if (chunk.magic != RECORD_MAGIC || chunk.size > _size - pos - sizeof(chunk)) break;
+        const uint8_t* data = &_map[pos + sizeof(chunk)];
+        pos += sizeof(chunk) + chunk.size;
+
+        switch (chunk.kind)
+        {
+        case RecordKind::SESSION:
+            local.clear();
+            break;
+        case RecordKind::CHANNEL:
+        {
+            if (chunk.count > chunk.size || chunk.width == 0) break;
+            frozen::string name((const char*)data, chunk.count);
+            size_t         ch = find(name);
+            if (ch == channels()) _channels.push_back({name, chunk.width, 0, {}});
+            if (local.size() <= chunk.channel) local.resize(chunk.channel + 1, SIZE_MAX);
+            // 名称相同但长度不同的属性不合并
+            local[chunk.channel] = _channels[ch].width == chunk.width ? ch : SIZE_MAX;
+            break;
+        }
+        case RecordKind::DATA:
+        {
+            if (chunk.channel >= local.size() || local[chunk.channel] == SIZE_MAX) break;
+            Channel& ch = _channels[local[chunk.channel]];
+            if (chunk.width != ch.width || chunk.count == 0) break;
+            if ((size_t)chunk.count * (sizeof(uint64_t) + ch.width) > chunk.size) break;
+            ch.segments.push_back({
+                .times  = (const uint64_t*)data,
+                .values = data + chunk.count * sizeof(uint64_t),
+                .first  = ch.count,
+                .count  = chunk.count,
+            });
+            ch.count += chunk.count;
+            break;
+        }
+        default:
+            break;
+        }
+    }
+    return ErrorCode::S_OK;
+}
+
+/**
+ * @brief 解除映射
+ *
+ */
+void Replay::close()
+{
+    _channels.clear();
+    if (_map) munmap((void*)_map, _size);
+    _map  = nullptr;
+    _size = 0;
+}
+
+/**
+ * @brief 根据属性名称查找通道
+ *
+ * @param name 属性名称
+ * @return size_t 通道, 不存在时为 channels()
+ */
+size_t Replay::find(const frozen::string name) const
+{
+    size_t ch = 0;
+    while (ch < _channels.size() && !(_channels[ch].name == name))
+        ch++;
+    return ch;
+}
+
+/**
+ * @brief 获取采样点
+ *
+ * @param channel 通道
+ * @param index 采样点序号
+ * @param time [out]时间戳
+ * @param value [out]采样值, 指向映射区
+ * @return true 获取成功
+ * @return false 序号越界
+ */
+bool Replay::at(size_t channel, size_t index, uint64_t& time, const uint8_t*& value) const
+{
+    const Segment* seg = segment(channel, index);
+    if (!seg) return false;
+
+    size_t offset = index - seg->first;
+    // 映射区中的块已按 8 字节对齐
+    time          = seg->times[offset];
+    value         = &seg->values[offset * _channels[channel].width];
+    return true;
+}
+
+/**
+ * @brief 查找时间戳不小于 time 的第一个采样点
+ *
+ * @param channel 通道
+ * @param time 时间戳
+ * @return size_t 采样点序号, 不存在时为 size(channel)
+ */
+size_t Replay::lower_bound(size_t channel, uint64_t time) const
+{
+    const std::vector<Segment>& segs = _channels[channel].segments;
+
+    auto seg = std::lower_bound(segs.begin(), segs.end(), time,
+                                [](const Segment& s, uint64_t t) { return s.times[s.count - 1] < t; });
+    if (seg == segs.end()) return _channels[channel].count;
+    return seg->first + (std::lower_bound(seg->times, seg->times + seg->count, time) - seg->times);
+}
+
+/**
+ * @brief 查找采样点所在的块
+ *
+ * @param channel 通道
+ * @param index 采样点序号
+ * @return const Segment* 采样点所在的块, 越界时为空
+ */
+const Replay::Segment* Replay::segment(size_t channel, size_t index) const
+{
+    if (channel >= _channels.size() || index >= _channels[channel].count) return nullptr;
+
+    const std::vector<Segment>& segs = _channels[channel].segments;
+
+    auto seg = std::upper_bound(segs.begin(), segs.end(), index,
+                                [](size_t i, const Segment& s) { return i < s.first; });
+    return &*(seg - 1);
+}
+
+ErrorCode ReplayProperty::get(Extra& extra, bool) const
+{
+    uint64_t       time;
+    const uint8_t* value;
+    if (!_replay.at(_channel, _cursor, time, value)) return ErrorCode::E_OUT_OF_INDEX;
+    // 读到最后一个采样点后保持不变
+    if (_cursor + 1 < _replay.size(_channel)) _cursor++;
+
+    extra.reset();
+    if (!extra.add(value, _replay.width(_channel))) return ErrorCode::E_OUT_OF_BUFFER;
+    return ErrorCode::S_OK;
+}
+
+ErrorCode ReplayProperty::get_size(Extra& extra, bool) const
+{
+    extra.reset();
+    extra.add<Size>(_replay.width(_channel));
+    return ErrorCode::S_OK;
+}
+
+Size ReplayProperty::sample(uint8_t* buf) const
+{
+    if (!buf) return _replay.width(_channel);
+
+    uint64_t       time;
+    const uint8_t* value;
+    if (!_replay.at(_channel, _cursor, time, value)) return 0;
+    if (_cursor + 1 < _replay.size(_channel)) _cursor++;
+    memcpy(buf, value, _replay.width(_channel));
+    return _replay.width(_channel);
+}
+
+/**
+ * @brief 移动到指定的采样点
+ *
+ * @param index 采样点序号
+ */
+void ReplayProperty::seek(size_t index)
+{
+    size_t size = _replay.size(_channel);
+    _cursor     = index < size ? index : (size == 0 ? 0 : size - 1);
+}
+
+/**
+ * @brief 移动到时间戳不小于 time 的第一个采样点
+ *
+ * @param time 时间戳
+ */
+void ReplayProperty::seek_time(uint64_t time)
+{
+    seek(_replay.lower_bound(_channel, time));
+}
+
+/**
+ * @param replay 已打开的记录文件, 打开其他文件后需要重新构造
+ */
+ReplayHolder::ReplayHolder(const Replay& replay)
+    : _replay(replay)
+{
+    _symbols._holder = this;
+    _props.reserve(replay.channels());
+    for (size_t i = 0; i < replay.channels(); i++)
+        _props.emplace_back(replay, i);
+}
+
+PropertyBase* ReplayHolder::get(PropertyId id) const
+{
+    if (id == 0) return (PropertyBase*)&_symbols;
+    if (id > _props.size()) return nullptr;
+    return (PropertyBase*)&_props[id - 1];
+}
+
+frozen::string ReplayHolder::get_desc(PropertyId id) const
+{
+    if (id == 0) return "symbols";
+    if (id > _props.size()) return "";
+    return _replay.name(id - 1);
+}
+
+size_t ReplayHolder::size() const
+{
+    // 超出 PropertyId 范围的通道不可访问
+    return std::min<size_t>(_props.size() + 1, UINT16_MAX);
+}
+
+/**
+ * @brief 所有属性回到第一个采样点
+ *
+ */
+void ReplayHolder::rewind()
+{
+    for (ReplayProperty& prop : _props)
+        prop.seek(0);
+}
+
+/**
+ * @brief 所有属性移动到时间戳不小于 time 的第一个采样点
+ *
+ * @param time 时间戳
+ */
+void ReplayHolder::seek(uint64_t time)
+{
+    for (ReplayProperty& prop : _props)
+        prop.seek_time(time);
+}
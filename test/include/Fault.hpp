@@ -0,0 +1,177 @@
+#pragma once
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <random>
+#include <stdint.h>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief 故障注入参数, 概率均按字节或比特独立发生
+ *
+ */
+struct FaultConfig
+{
+    // 比特翻转率
+    double   Flip      = 0;
+    // 字节丢失率
+    double   Drop      = 0;
+    // 字节重复率
+    double   Duplicate = 0;
+    // 字节前停顿的概率
+    double   Stall     = 0;
+    // 每次停顿的时长
+    uint32_t StallUs   = 0;
+    // 随机数种子, 相同的种子产生相同的故障序列
+    uint64_t Seed      = 1;
+};
+
+struct FaultStats
+{
+    uint64_t Bytes      = 0;
+    uint64_t Flips      = 0;
+    uint64_t Drops      = 0;
+    uint64_t Duplicates = 0;
+    uint64_t Stalls     = 0;
+};
+
+/**
+ * @brief 向字节流注入故障
+ *
+ * @note 按几何分布抽取到下一个故障的间隔, 无故障的字节不消耗随机数
+ */
+struct FaultInjector
+{
+    FaultStats Stats;
+
+    FaultInjector(const FaultConfig& config)
+        : _config(config)
+        , _rng(config.Seed)
+    {
+        _flip_gap  = gap(config.Flip);
+        _drop_gap  = gap(config.Drop);
+        _dup_gap   = gap(config.Duplicate);
+        _stall_gap = gap(config.Stall);
+    }
+
+    /**
+     * @brief 注入故障
+     *
+     * @param in 原字节流
+     * @param size 长度
+     * @param out [out]注入故障后的字节流, 追加在末尾
+     * @return uint32_t 发送或接收前需要停顿的时长(us)
+     */
+    uint32_t apply(const uint8_t* in, size_t size, std::vector<uint8_t>& out)
+    {
+        uint32_t stall = 0;
+        for (size_t i = 0; i < size; i++)
+        {
+            Stats.Bytes++;
+            if (step(_stall_gap, _config.Stall))
+            {
+                Stats.Stalls++;
+                stall += _config.StallUs;
+            }
+            if (step(_drop_gap, _config.Drop))
+            {
+                Stats.Drops++;
+                continue;
+            }
+
+            uint8_t byte = in[i];
+            while (_flip_gap < 8)
+            {
+                Stats.Flips++;
+                byte      ^= 1 << _flip_gap;
+                _flip_gap += 1 + gap(_config.Flip);
+            }
+            _flip_gap -= 8;
+
+            out.push_back(byte);
+            if (step(_dup_gap, _config.Duplicate))
+            {
+                Stats.Duplicates++;
+                out.push_back(byte);
+            }
+        }
+        return stall;
+    }
+
+  protected:
+    uint64_t gap(double p)
+    {
+        if (p <= 0) return UINT64_MAX / 2;
+        if (p >= 1) return 0;
+        double u = std::uniform_real_distribution<double>(0, 1)(_rng);
+        return (uint64_t)std::min(std::floor(std::log1p(-u) / std::log1p(-p)), (double)(UINT64_MAX / 4));
+    }
+
+    bool step(uint64_t& counter, double p)
+    {
+        if (counter-- > 0) return false;
+        counter = gap(p);
+        return true;
+    }
+
+  protected:
+    FaultConfig     _config;
+    std::mt19937_64 _rng;
+    uint64_t        _flip_gap;
+    uint64_t        _drop_gap;
+    uint64_t        _dup_gap;
+    uint64_t        _stall_gap;
+};
+
+/**
+ * @brief 故障注入传输层, 包装任意 HostBase 实现的 rx/tx
+ *
+ * @tparam Base HostBase 的派生类
+ */
+template <typename Base>
+struct FaultTransport : public Base
+{
+    FaultInjector RxFault;
+    FaultInjector TxFault;
+
+    template <typename... Args>
+    FaultTransport(const FaultConfig& rx, const FaultConfig& tx, Args&&... args)
+        : Base(std::forward<Args>(args)...)
+        , RxFault(rx)
+        , TxFault(tx)
+    {
+    }
+
+  protected:
+    virtual bool rx(uint8_t& byte) override
+    {
+        while (_rx.empty())
+        {
+            uint8_t              raw;
+            std::vector<uint8_t> out;
+            if (!Base::rx(raw)) return false;
+            pause(RxFault.apply(&raw, 1, out));
+            _rx.insert(_rx.end(), out.begin(), out.end());
+        }
+        byte = _rx.front();
+        _rx.pop_front();
+        return true;
+    }
+
+    virtual void tx(const void* buf, size_t size) override
+    {
+        _tx.clear();
+        pause(TxFault.apply((const uint8_t*)buf, size, _tx));
+        if (!_tx.empty()) Base::tx(_tx.data(), _tx.size());
+    }
+
+    static void pause(uint32_t us)
+    {
+        if (us > 0) std::this_thread::sleep_for(std::chrono::microseconds(us));
+    }
+
+  protected:
+    std::deque<uint8_t>  _rx;
+    std::vector<uint8_t> _tx;
+};
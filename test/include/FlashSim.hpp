@@ -0,0 +1,54 @@
+#pragma once
+#include <FlashMemory.hpp>
+
+/**
+ * @brief 使用内存模拟的闪存
+ *
+ * @note 擦除后数据为 0xFF, 写入只能将 1 变为 0
+ *
+ * @tparam _size 闪存大小
+ * @tparam _page 闪存页大小
+ */
+template <size_t _size, size_t _page>
+struct FlashSim : public FlashDriver
+{
+    std::array<uint8_t, _size> Flash;
+    // 擦除次数
+    size_t                     Erased     = 0;
+    // 写入次数
+    size_t                     Programmed = 0;
+    // 写入失败的页
+    size_t                     BadPage    = SIZE_MAX;
+
+    FlashSim()
+    {
+        Flash.fill(0xFF);
+    }
+
+    virtual ErrorCode read(size_t addr, void* buf, size_t size) override
+    {
+        if (addr + size > _size) return ErrorCode::E_OUT_OF_INDEX;
+        memcpy(buf, &Flash[addr], size);
+        return ErrorCode::S_OK;
+    }
+
+    virtual ErrorCode erase(size_t addr) override
+    {
+        if (addr % _page != 0 || addr + _page > _size) return ErrorCode::E_ALIGN;
+        memset(&Flash[addr], 0xFF, _page);
+        Erased++;
+        return ErrorCode::S_OK;
+    }
+
+    virtual ErrorCode program(size_t addr, const void* buf, size_t size) override
+    {
+        if (addr + size > _size) return ErrorCode::E_OUT_OF_INDEX;
+        if (addr - addr % _page == BadPage) return ErrorCode::E_BAD_BLOCK;
+        for (size_t i = 0; i < size; i++)
+        {
+            Flash[addr + i] &= ((const uint8_t*)buf)[i];
+        }
+        Programmed++;
+        return ErrorCode::S_OK;
+    }
+};
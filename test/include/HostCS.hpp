@@ -3,6 +3,7 @@
 #include <Extra.hpp>
 #include <HostClient.hpp>
 #include <HostServer.hpp>
+#include <string>
 #include <thread>
 
 struct SecretHolderImpl : public SecretHolder
@@ -14,9 +15,12 @@ struct SecretHolderImpl : public SecretHolder
 
 struct HostClientImpl : public HostClient
 {
-    Address           address;
+    Address           address = 0;
     FixedQueue<2048>* Q_Server;
     FixedQueue<2048>  Q_Client;
+    size_t            Logs = 0;
+    LogLevel          LastLevel;
+    std::string       LastLog;
 
     HostClientImpl(CPropertyHolderBase& holder, SecretHolder& secret)
         : HostClient(address, holder, secret)
@@ -38,20 +42,25 @@ struct HostClientImpl : public HostClient
         }
     }
 
-    virtual void log_output(LogLevel, const uint8_t*, size_t) override
+    virtual void log_output(LogLevel level, const uint8_t* log, size_t size) override
     {
+        Logs++;
+        LastLevel = level;
+        LastLog.assign((const char*)log, size);
     }
 };
 
 struct HostServerImpl : public HostServer
 {
-    Address           address;
+    Address           address = 0;
     bool              Running = true;
     FixedQueue<2048>  Q_Server;
     FixedQueue<2048>* Q_Client;
+    size_t            TxCalls = 0;
 
-    HostServerImpl(const PropertyHolderBase& holder, SecretHolder& secret)
-        : HostServer(address, holder, secret)
+    HostServerImpl(const PropertyHolderBase& holder, SecretHolder& secret, Lock& tx_lock = no_lock,
+                   Lock& prop_lock = no_lock)
+        : HostServer(address, holder, secret, tx_lock, prop_lock)
     {
     }
 
@@ -69,6 +78,7 @@ struct HostServerImpl : public HostServer
 
     virtual void tx(const void* buf, size_t size) override
     {
+        TxCalls++;
         for (size_t i = 0; i < size; i++)
         {
             Q_Client->push(((uint8_t*)buf)[i]);
@@ -82,8 +92,8 @@ struct HostCSBase
     HostServerImpl   server;
     HostClientImpl   client;
 
-    HostCSBase(const PropertyHolderBase& holder, CPropertyHolderBase& cholder)
-        : server(holder, secret)
+    HostCSBase(const PropertyHolderBase& holder, CPropertyHolderBase& cholder, Lock& tx_lock = no_lock)
+        : server(holder, secret, tx_lock)
         , client(cholder, secret)
     {
         server.Q_Client = &client.Q_Client;
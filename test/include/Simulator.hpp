@@ -0,0 +1,524 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <Fault.hpp>
+#include <HostClient.hpp>
+#include <HostServer.hpp>
+#include <memory>
+#include <poll.h>
+#include <random>
+#include <stdio.h>
+#include <string>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using SimClock = std::chrono::steady_clock;
+
+/**
+ * @brief 链路损伤参数, 作用于设备端收发的字节流
+ *
+ */
+struct SimImpair
+{
+    // 设备应答的延迟
+    uint32_t LatencyUs = 0;
+    // 比特误码率
+    double   Ber       = 0;
+    // 字节丢失率
+    double   Loss      = 0;
+
+    FaultConfig fault(uint64_t seed) const
+    {
+        FaultConfig config;
+        config.Flip = Ber;
+        config.Drop = Loss;
+        config.Seed = seed;
+        return config;
+    }
+};
+
+/**
+ * @brief 带超时的套接字字节流
+ *
+ */
+struct SimStream
+{
+    int      Fd        = -1;
+    int      TimeoutMs = 20;
+    // 收发的字节数
+    uint64_t RxBytes   = 0;
+    uint64_t TxBytes   = 0;
+
+    ~SimStream()
+    {
+        if (Fd >= 0) close(Fd);
+    }
+
+    /**
+     * @brief 是否有已缓存未读取的字节
+     *
+     */
+    bool buffered() const
+    {
+        return _pos < _rx.size();
+    }
+
+    bool read(uint8_t& byte, FaultInjector* fault)
+    {
+        while (_pos >= _rx.size())
+        {
+            pollfd pfd = {Fd, POLLIN, 0};
+            if (::poll(&pfd, 1, TimeoutMs) <= 0) return false;
+            ssize_t n = ::read(Fd, _buf, sizeof(_buf));
+            if (n <= 0) return false;
+            RxBytes += n;
+            _pos     = 0;
+            _rx.clear();
+            if (fault)
+                fault->apply(_buf, n, _rx);
+            else
+                _rx.assign(_buf, _buf + n);
+        }
+        byte = _rx[_pos++];
+        return true;
+    }
+
+    void write(const void* buf, size_t size)
+    {
+        const uint8_t* ptr = (const uint8_t*)buf;
+        while (size > 0)
+        {
+            ssize_t n = ::write(Fd, ptr, size);
+            if (n <= 0) return;
+            TxBytes += n;
+            ptr     += n;
+            size    -= n;
+        }
+    }
+
+    /**
+     * @brief 丢弃缓存和套接字中未读取的字节
+     *
+     */
+    void drain()
+    {
+        _pos       = 0;
+        _rx.clear();
+        pollfd pfd = {Fd, POLLIN, 0};
+        while (::poll(&pfd, 1, 0) > 0 && ::read(Fd, _buf, sizeof(_buf)) > 0)
+            ;
+    }
+
+  protected:
+    uint8_t              _buf[512];
+    // 注入故障后的字节流
+    std::vector<uint8_t> _rx;
+    size_t               _pos = 0;
+};
+
+struct SimSecret : public SecretHolder
+{
+    virtual void update_nonce() override
+    {
+    }
+};
+
+/**
+ * @brief 模拟的设备, 0号属性为 symbols, 其余为生成的 uint32_t 属性
+ *
+ * @note 第 i 号属性的初值为 (序号 << 16) | i, 便于 Host 校验应答
+ *
+ * @tparam _props 生成的属性个数
+ */
+template <size_t _props>
+struct SimDevice : public HostServer
+{
+    SimStream Stream;
+
+    SimDevice(const std::vector<std::string>& names, size_t index, int fd, const SimImpair& impair, uint64_t seed,
+              SecretHolder& secret)
+        : HostServer(_address, _prop_holder, secret)
+        , _address(index % 254 + 1)
+        , _props_buf(make_props(_values, index))
+        , _map(make_map(names, _symbols, _props_buf, std::make_index_sequence<_props>()))
+        , _prop_holder(_map, _symbols)
+        , _impair(impair)
+        , _fault(impair.fault(seed))
+    {
+        Stream.Fd        = fd;
+        Stream.TimeoutMs = 5;
+    }
+
+    /**
+     * @brief 处理已到达的请求, 应答按链路延迟排队
+     *
+     * @param now 当前时间
+     */
+    void serve(SimClock::time_point now)
+    {
+        do
+        {
+            poll();
+            if (_out.empty()) continue;
+            std::vector<uint8_t> frame;
+            _fault.apply(_out.data(), _out.size(), frame);
+            _delayed.push_back({now + std::chrono::microseconds(_impair.LatencyUs), std::move(frame)});
+            _out.clear();
+        } while (Stream.buffered());
+    }
+
+    /**
+     * @brief 发送到期的应答
+     *
+     * @param now 当前时间
+     * @return SimClock::time_point 下一个应答的到期时间
+     */
+    SimClock::time_point release(SimClock::time_point now)
+    {
+        while (!_delayed.empty() && _delayed.front().first <= now)
+        {
+            Stream.write(_delayed.front().second.data(), _delayed.front().second.size());
+            _delayed.pop_front();
+        }
+        return _delayed.empty() ? SimClock::time_point::max() : _delayed.front().first;
+    }
+
+    Address address_of() const
+    {
+        return _address;
+    }
+
+  protected:
+    using Prop = Property<uint32_t, Access::READ_WRITE>;
+
+    static std::vector<Prop> make_props(uint32_t (&values)[_props], size_t index)
+    {
+        std::vector<Prop> props;
+        props.reserve(_props);
+        for (size_t i = 0; i < _props; i++)
+        {
+            values[i] = (index << 16) | (i + 1);
+            props.emplace_back(values[i]);
+        }
+        return props;
+    }
+
+    template <size_t... I>
+    static PropertyMap<_props + 1> make_map(const std::vector<std::string>& names, PropertySymbols& symbols,
+                                            std::vector<Prop>& props, std::index_sequence<I...>)
+    {
+        using Item = std::pair<frozen::string, PropertyBase*>;
+        return {
+            {Item{"symbols", &symbols}, Item{frozen::string(names[I].data(), names[I].size()), &props[I]}...}
+        };
+    }
+
+    virtual bool rx(uint8_t& byte) override
+    {
+        return Stream.read(byte, &_fault);
+    }
+
+    virtual void tx(const void* buf, size_t size) override
+    {
+        _out.insert(_out.end(), (const uint8_t*)buf, (const uint8_t*)buf + size);
+    }
+
+  protected:
+    Address                                                           _address;
+    uint32_t                                                          _values[_props];
+    std::vector<Prop>                                                 _props_buf;
+    PropertySymbols                                                   _symbols;
+    PropertyMap<_props + 1>                                           _map;
+    PropertyHolder<_props + 1>                                        _prop_holder;
+    SimImpair                                                         _impair;
+    FaultInjector                                                     _fault;
+    std::vector<uint8_t>                                              _out;
+    // 排队中的应答, 按到期时间排列
+    std::deque<std::pair<SimClock::time_point, std::vector<uint8_t>>> _delayed;
+};
+
+/**
+ * @brief 负载端的 Client, 按属性Id直接访问
+ *
+ */
+struct SimHost : public HostClient
+{
+    struct Ids : public CPropertyHolderBase
+    {
+        virtual ErrorCode get_id_by_name(const frozen::string, PropertyId&) const override
+        {
+            return ErrorCode::E_ID_NOT_EXIST;
+        }
+
+        virtual ErrorCode refresh(HostClient&) override
+        {
+            return ErrorCode::S_OK;
+        }
+    };
+
+    SimStream Stream;
+
+    SimHost(Address address, int fd, int timeout_ms, SecretHolder& secret)
+        : HostClient(_address, _ids, secret)
+        , _address(address)
+    {
+        Stream.Fd        = fd;
+        Stream.TimeoutMs = timeout_ms;
+    }
+
+    /**
+     * @brief 读取属性值
+     *
+     * @param id 属性Id
+     * @param value [out]属性值
+     * @return ErrorCode 错误码
+     */
+    ErrorCode get(PropertyId id, uint32_t& value)
+    {
+        ErrorCode err;
+        extra.reset();
+        extra.add(id);
+        send(Command::GET_PROPERTY, extra, false);
+        if (!recv_response(Command::GET_PROPERTY, err, extra))
+        {
+            // 超时后丢弃迟到的应答, 重新同步
+            Stream.drain();
+            _buf_head.reset();
+            return ErrorCode::E_TIMEOUT;
+        }
+        if (err != ErrorCode::S_OK) return err;
+        if (!extra.get(value)) return ErrorCode::E_FAIL;
+        return ErrorCode::S_OK;
+    }
+
+  protected:
+    virtual bool rx(uint8_t& byte) override
+    {
+        return Stream.read(byte, nullptr);
+    }
+
+    virtual void tx(const void* buf, size_t size) override
+    {
+        Stream.write(buf, size);
+    }
+
+    virtual void log_output(LogLevel, const uint8_t*, size_t) override
+    {
+    }
+
+  protected:
+    Address _address;
+    Ids     _ids;
+};
+
+struct SimConfig
+{
+    // 设备数
+    size_t    Devices   = 64;
+    // 运行设备的线程数
+    size_t    Servers   = 2;
+    // 产生负载的线程数
+    size_t    Hosts     = 4;
+    // 每个设备的请求数
+    size_t    Requests  = 20;
+    // Host 的应答超时
+    int       TimeoutMs = 20;
+    // 链路损伤
+    SimImpair Impair;
+    // 随机数种子, 相同的种子产生相同的请求序列和损伤
+    uint64_t  Seed      = 1;
+};
+
+struct SimReport
+{
+    size_t                Requests   = 0;
+    size_t                Ok         = 0;
+    size_t                Timeouts   = 0;
+    size_t                Errors     = 0;
+    // 应答成功但属性值不符
+    size_t                Mismatches = 0;
+    uint64_t              Bytes      = 0;
+    double                Seconds    = 0;
+    // 成功请求的往返时间(us), 已排序
+    std::vector<uint32_t> Latency;
+
+    uint32_t percentile(double p) const
+    {
+        if (Latency.empty()) return 0;
+        size_t index = std::min(Latency.size() - 1, (size_t)(p / 100 * Latency.size()));
+        return Latency[index];
+    }
+
+    double throughput() const
+    {
+        return Seconds > 0 ? Ok / Seconds : 0;
+    }
+
+    void print(FILE* out) const
+    {
+        fprintf(out, "requests %zu ok %zu timeout %zu error %zu mismatch %zu\n", Requests, Ok, Timeouts, Errors,
+                Mismatches);
+        fprintf(out, "%.3f s, %.0f req/s, %.1f KiB/s\n", Seconds, throughput(),
+                Seconds > 0 ? Bytes / Seconds / 1024 : 0);
+        fprintf(out, "latency us p50 %u p90 %u p99 %u max %u\n", percentile(50), percentile(90), percentile(99),
+                Latency.empty() ? 0 : Latency.back());
+    }
+};
+
+/**
+ * @brief 多设备模拟器
+ *
+ * @details
+ * 每个设备通过一对套接字与一个 Host 端的 Client 相连, 设备由 Servers 个线程轮询, 负载由 Hosts 个线程产生;
+ * 每个负载线程依次向分到的设备发送 GET_PROPERTY 请求, 统计应答结果和往返时间
+ *
+ * @tparam _props 每个设备生成的属性个数
+ */
+template <size_t _props>
+struct Simulator
+{
+    Simulator(const SimConfig& config)
+        : _config(config)
+    {
+        // 每个设备占用 2 个文件描述符
+        rlimit lim;
+        if (getrlimit(RLIMIT_NOFILE, &lim) == 0 && lim.rlim_cur < 2 * config.Devices + 64)
+        {
+            lim.rlim_cur = std::min<rlim_t>(lim.rlim_max, 2 * config.Devices + 64);
+            setrlimit(RLIMIT_NOFILE, &lim);
+        }
+
+        for (size_t i = 0; i < _props; i++)
+            _names.push_back("sim." + std::to_string(i));
+
+        for (size_t i = 0; i < config.Devices; i++)
+        {
+            int fds[2];
+            if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) break;
+            _devices.push_back(
+                std::make_unique<SimDevice<_props>>(_names, i, fds[0], config.Impair, config.Seed * 7919 + i, _secret));
+            _hosts.push_back(std::make_unique<SimHost>(_devices.back()->address_of(), fds[1], config.TimeoutMs, _secret));
+        }
+    }
+
+    /**
+     * @brief 创建成功的设备数
+     *
+     */
+    size_t size() const
+    {
+        return _devices.size();
+    }
+
+    SimReport run()
+    {
+        std::atomic<bool>        running = true;
+        std::vector<std::thread> servers;
+        for (size_t t = 0; t < _config.Servers; t++)
+            servers.emplace_back([this, t, &running]() { serve(t, running); });
+
+        std::vector<SimReport>   reports(_config.Hosts);
+        std::vector<std::thread> hosts;
+        auto                     start = SimClock::now();
+        for (size_t t = 0; t < _config.Hosts; t++)
+            hosts.emplace_back([this, t, &reports]() { load(t, reports[t]); });
+        for (std::thread& thread : hosts)
+            thread.join();
+        auto stop = SimClock::now();
+
+        running = false;
+        for (std::thread& thread : servers)
+            thread.join();
+
+        SimReport report;
+        for (SimReport& part : reports)
+        {
+            report.Requests   += part.Requests;
+            report.Ok         += part.Ok;
+            report.Timeouts   += part.Timeouts;
+            report.Errors     += part.Errors;
+            report.Mismatches += part.Mismatches;
+            report.Latency.insert(report.Latency.end(), part.Latency.begin(), part.Latency.end());
+        }
+        for (std::unique_ptr<SimHost>& host : _hosts)
+            report.Bytes += host->Stream.RxBytes + host->Stream.TxBytes;
+        std::sort(report.Latency.begin(), report.Latency.end());
+        report.Seconds = std::chrono::duration<double>(stop - start).count();
+        return report;
+    }
+
+  protected:
+    void serve(size_t thread, std::atomic<bool>& running)
+    {
+        std::vector<SimDevice<_props>*> devices;
+        std::vector<pollfd>             fds;
+        for (size_t i = thread; i < _devices.size(); i += _config.Servers)
+        {
+            devices.push_back(_devices[i].get());
+            fds.push_back({_devices[i]->Stream.Fd, POLLIN, 0});
+        }
+
+        while (running)
+        {
+            auto now  = SimClock::now();
+            auto next = SimClock::time_point::max();
+            for (SimDevice<_props>* device : devices)
+                next = std::min(next, device->release(now));
+
+            // 等待请求或下一个应答到期, 最长 1ms 以便检查退出
+            auto     wait = std::min<SimClock::duration>(next - now, std::chrono::milliseconds(1));
+            timespec ts   = {0, (long)std::chrono::duration_cast<std::chrono::nanoseconds>(wait).count()};
+            if (ppoll(fds.data(), fds.size(), &ts, nullptr) <= 0) continue;
+
+            now = SimClock::now();
+            for (size_t i = 0; i < fds.size(); i++)
+            {
+                if (fds[i].revents & POLLIN) devices[i]->serve(now);
+            }
+        }
+    }
+
+    void load(size_t thread, SimReport& report)
+    {
+        std::mt19937                            rng(_config.Seed * 104729 + thread);
+        std::uniform_int_distribution<uint16_t> pick(1, _props);
+
+        for (size_t r = 0; r < _config.Requests; r++)
+        {
+            for (size_t i = thread; i < _hosts.size(); i += _config.Hosts)
+            {
+                PropertyId id = pick(rng);
+                uint32_t   value;
+                auto       start = SimClock::now();
+                ErrorCode  err   = _hosts[i]->get(id, value);
+                auto       us    = std::chrono::duration_cast<std::chrono::microseconds>(SimClock::now() - start);
+
+                report.Requests++;
+                if (err == ErrorCode::E_TIMEOUT)
+                    report.Timeouts++;
+                else if (err != ErrorCode::S_OK)
+                    report.Errors++;
+                else if (value != ((i << 16) | id))
+                    report.Mismatches++;
+                else
+                {
+                    report.Ok++;
+                    report.Latency.push_back(us.count());
+                }
+            }
+        }
+    }
+
+  protected:
+    SimConfig                                       _config;
+    SimSecret                                       _secret;
+    std::vector<std::string>                        _names;
+    std::vector<std::unique_ptr<SimDevice<_props>>> _devices;
+    std::vector<std::unique_ptr<SimHost>>           _hosts;
+};
@@ -0,0 +1,112 @@
+#include "gtest/gtest.h"
+#include <Aead.hpp>
+#include <chrono>
+#include <Extra.hpp>
+#include <vector>
+
+static KeyType MakeKey()
+{
+    KeyType key;
+    for (size_t i = 0; i < key.size(); i++)
+        key[i] = 0xA0 + i;
+    return key;
+}
+
+static NonceType MakeNonce(uint32_t seq)
+{
+    // 填满所有字节, 包括与 CCM 计数器共用最后 4 字节的部分
+    NonceType nonce;
+    for (size_t i = 0; i < nonce.size(); i++)
+        nonce[i] = (seq >> (8 * (i % 4))) + i * 0x11;
+    return nonce;
+}
+
+// 硬件实现与 uAES 的输出逐字节一致
+TEST(Aead, Equivalence)
+{
+    KeyType key = MakeKey();
+    printf("AES-NI/PCLMUL: %s\n", aead_hw_supported() ? "yes" : "no");
+
+    for (uint8_t value = 0; value < 0x0C; value++)
+    {
+        CipherSuite suite;
+        ASSERT_TRUE(CipherSuite::decode(value, suite));
+        for (size_t size : {1, 4, 15, 16, 17, 63, 64, 65, 100, 1024})
+        {
+            NonceType            nonce = MakeNonce(value * 10000 + size);
+            std::vector<uint8_t> plain(size);
+            for (size_t i = 0; i < size; i++)
+                plain[i] = i * 7 + value;
+
+            std::vector<uint8_t> sw = plain, hw = plain;
+            uint8_t              sw_tag[16], hw_tag[16];
+            aead_encrypt_sw(suite, key, nonce, sw.data(), size, sw_tag);
+            aead_encrypt_hw(suite, key, nonce, hw.data(), size, hw_tag);
+            ASSERT_EQ(sw, hw) << "suite " << (int)value << " size " << size;
+            ASSERT_EQ(memcmp(sw_tag, hw_tag, suite.tag_size()), 0) << "suite " << (int)value << " size " << size;
+
+            // 交叉解密
+            ASSERT_TRUE(aead_decrypt_hw(suite, key, nonce, sw.data(), size, sw_tag));
+            ASSERT_EQ(sw, plain);
+            ASSERT_TRUE(aead_decrypt_sw(suite, key, nonce, hw.data(), size, hw_tag));
+            ASSERT_EQ(hw, plain);
+
+            // 篡改密文
+            aead_encrypt_sw(suite, key, nonce, sw.data(), size, sw_tag);
+            sw[size / 2] ^= 0x80;
+            EXPECT_FALSE(aead_decrypt_hw(suite, key, nonce, sw.data(), size, sw_tag));
+        }
+    }
+}
+
+/**
+ * @brief 每秒可加密的帧数, 包括构造 Extra, 加密和解密
+ *
+ */
+template <typename Encrypt, typename Decrypt>
+static double FramesPerSecond(const CipherSuite& suite, size_t size, Encrypt encrypt, Decrypt decrypt)
+{
+    using namespace std::chrono;
+    KeyType              key    = MakeKey();
+    NonceType            nonce  = MakeNonce(1);
+    size_t               frames = 0;
+    std::vector<uint8_t> data(size, 0x5A);
+    uint8_t              tag[16];
+
+    auto                 start  = steady_clock::now();
+    auto                 end    = start;
+    do
+    {
+        for (size_t i = 0; i < 256; i++)
+        {
+            encrypt(suite, key, nonce, data.data(), size, tag);
+            if (!decrypt(suite, key, nonce, data.data(), size, tag)) return 0;
+        }
+        frames += 256;
+        end     = steady_clock::now();
+    } while (end - start < milliseconds(50));
+    return frames / duration<double>(end - start).count();
+}
+
+TEST(Aead, Benchmark)
+{
+    const CipherSuite suites[] = {
+        {CipherMode::CCM, CipherKey::AES256, CipherTag::TAG16},
+        {CipherMode::GCM, CipherKey::AES256, CipherTag::TAG16},
+        {CipherMode::GCM, CipherKey::AES128, CipherTag::TAG8 },
+    };
+    const char* names[] = {"CCM-256/16", "GCM-256/16", "GCM-128/8"};
+
+    printf("%-12s %8s %14s %14s %8s\n", "suite", "payload", "uAES(f/s)", "AES-NI(f/s)", "speedup");
+    for (size_t s = 0; s < std::size(suites); s++)
+    {
+        for (size_t size : {4, 64, 1024})
+        {
+            double sw = FramesPerSecond(suites[s], size, aead_encrypt_sw, aead_decrypt_sw);
+            double hw = FramesPerSecond(suites[s], size, aead_encrypt_hw, aead_decrypt_hw);
+            printf("%-12s %8zu %14.0f %14.0f %7.1fx\n", names[s], size, sw, hw, hw / sw);
+            EXPECT_GT(sw, 0);
+            EXPECT_GT(hw, 0);
+        }
+    }
+}
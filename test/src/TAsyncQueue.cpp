@@ -0,0 +1,110 @@
+#include "gtest/gtest.h"
+#include <CProperty.hpp>
+#include <future>
+#include <HostCS.hpp>
+#include <mutex>
+
+TEST(AsyncQueue, PushPop)
+{
+    AsyncQueue<16> queue;
+    Extra          extra;
+    Command        cmd;
+    uint8_t        data[] = {1, 2, 3, 4};
+
+    EXPECT_FALSE(queue.pop(cmd, extra));
+    EXPECT_TRUE(queue.push(Command::LOG, data, sizeof(data)));
+    EXPECT_TRUE(queue.push(Command::LOG_BATCH, data, 2));
+    // 剩余空间不足
+    EXPECT_FALSE(queue.push(Command::LOG, data, sizeof(data)));
+    EXPECT_EQ(queue.dropped(), 1);
+
+    ASSERT_TRUE(queue.pop(cmd, extra));
+    EXPECT_EQ(cmd, Command::LOG);
+    EXPECT_EQ(extra.remain(), sizeof(data));
+    EXPECT_EQ(memcmp(extra.curr(), data, sizeof(data)), 0);
+    ASSERT_TRUE(queue.pop(cmd, extra));
+    EXPECT_EQ(cmd, Command::LOG_BATCH);
+    EXPECT_EQ(extra.remain(), 2);
+    EXPECT_FALSE(queue.pop(cmd, extra));
+}
+
+static float                    FloatVal;
+static Property<float>          Prop_1(FloatVal);
+// 静态初始化
+static constexpr PropertyMap<1> Map = {
+    {
+     {"prop.1", &(PropertyBase&)Prop_1},
+     }
+};
+static PropertyHolder            Holder(Map);
+
+static constinit CPropertyMap<1> CMap = {
+    {
+     {"prop.1", 0},
+     }
+};
+static CPropertyHolder CHolder(CMap);
+
+struct TAsyncQueue
+    : public HostCSBase
+    , public testing::Test
+{
+    MutexLock<std::mutex> QueueLock;
+    AsyncQueue<4096>      Queue;
+    bool                  Running = true;
+    std::future<void>     end;
+
+    TAsyncQueue()
+        : HostCSBase(Holder, CHolder)
+        , Queue(QueueLock)
+    {
+        client.async = &Queue;
+    }
+
+    virtual void SetUp()
+    {
+        end = std::async(std::launch::async,
+                         [this]()
+                         {
+                             while (Running)
+                             {
+                                 server.poll();
+                             }
+                         });
+    }
+
+    virtual void TearDown()
+    {
+        Running        = false;
+        server.Running = false;
+        end.get();
+    }
+};
+
+TEST_F(TAsyncQueue, Dispatch)
+{
+    float            value;
+    CProperty<float> c_prop("prop.1");
+
+    for (size_t i = 0; i < 5; i++)
+        server.log(LogLevel::INFO, "log", 3);
+
+    // 日志只入队, 不在事务中输出
+    FloatVal = 1.5;
+    ASSERT_EQ(c_prop.get(client, value), ErrorCode::S_OK);
+    EXPECT_EQ(value, 1.5);
+    EXPECT_EQ(client.Logs, 0);
+
+    // 由消费者输出
+    std::future<size_t> consumer = std::async(std::launch::async,
+                                              [this]()
+                                              {
+                                                  size_t count = 0;
+                                                  while (client.dispatch())
+                                                      count++;
+                                                  return count;
+                                              });
+    EXPECT_EQ(consumer.get(), 5);
+    EXPECT_EQ(client.Logs, 5);
+    EXPECT_EQ(client.LastLog, "log");
+}
@@ -0,0 +1,306 @@
+#include "gtest/gtest.h"
+#include <chrono>
+#include <CLatch.hpp>
+#include <CProperty.hpp>
+#include <future>
+#include <HostCS.hpp>
+#include <memory>
+
+static constinit CPropertyMap<4> CMap = {
+    {
+     {"setpoint", 0},
+     {"groups", 1},
+     {"counter", 2},
+     {"latch", 3},
+     }
+};
+static CPropertyHolder CHolder(CMap);
+
+/**
+ * @brief 总线上的一个设备
+ *
+ */
+struct Device
+{
+    uint32_t                                             Setpoint = 0;
+    uint32_t                                             Counter  = 0;
+    // 组播地址由属性保存, Client 可以配置
+    std::array<Address, 2>                               Groups;
+    Property<uint32_t, Access::READ_WRITE>               P_Setpoint {Setpoint};
+    Property<std::array<Address, 2>, Access::READ_WRITE> P_Groups {Groups};
+    Property<uint32_t>                                   P_Counter {Counter};
+    // 锁存 setpoint 和 counter
+    Latch<2>                                             P_Latch;
+    PropertyMap<4>                                       Map = {
+        {
+         {"setpoint", &P_Setpoint},
+         {"groups", &P_Groups},
+         {"counter", &P_Counter},
+         {"latch", &P_Latch},
+         }
+    };
+    PropertyHolder<4>                                    Holder {Map};
+    SecretHolderImpl                                     Secret;
+    HostServerImpl                                       Server {Holder, Secret};
+    std::future<void>                                    Task;
+
+    Device(Address address, Address group)
+    {
+        Groups         = {group, ADDRESS_BROADCAST};
+        Server.address = address;
+        Server.set_groups(Groups.data(), Groups.size());
+        P_Latch.add(&P_Setpoint);
+        P_Latch.add(&P_Counter);
+        Server.set_latch(&P_Latch);
+    }
+};
+
+/**
+ * @brief 总线上的 Client, 发送的字节所有设备都能收到
+ *
+ */
+struct BusClient : public HostClientImpl
+{
+    std::vector<Device*> Devices;
+
+    using HostClientImpl::HostClientImpl;
+
+    virtual void tx(const void* buf, size_t size) override
+    {
+        for (Device* device : Devices)
+            for (size_t i = 0; i < size; i++)
+                device->Server.Q_Server.push(((const uint8_t*)buf)[i]);
+    }
+};
+
+struct TBroadcast : public testing::Test
+{
+    static constexpr size_t              DEVICES = 4;
+
+    SecretHolderImpl                     secret;
+    BusClient                            client {CHolder, secret};
+    std::vector<std::unique_ptr<Device>> devices;
+    Address                              addresses[DEVICES];
+
+    virtual void SetUp()
+    {
+        for (size_t i = 0; i < DEVICES; i++)
+        {
+            // 偶数地址的设备属于组 0x80, 其余属于组 0x81
+            devices.push_back(std::make_unique<Device>(i + 1, i % 2 ? 0x80 : 0x81));
+            Device& device         = *devices.back();
+            device.Server.Q_Client = &client.Q_Client;
+            client.Devices.push_back(&device);
+            addresses[i] = i + 1;
+        }
+        for (auto& device : devices)
+        {
+            Device* d = device.get();
+            d->Task   = std::async(std::launch::async,
+                                   [d]()
+                                   {
+                                       while (d->Server.Running)
+                                           d->Server.poll();
+                                   });
+        }
+    }
+
+    virtual void TearDown()
+    {
+        for (auto& device : devices)
+        {
+            device->Server.Running = false;
+            device->Task.get();
+        }
+    }
+
+    // 等待所有设备解析完 frames 帧, 包括跳过的帧
+    void wait(uint32_t frames)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (auto& device : devices)
+        {
+            while (device->Server.stats().frames + device->Server.stats().foreign < frames &&
+                   std::chrono::steady_clock::now() - start < std::chrono::seconds(5))
+                std::this_thread::yield();
+        }
+    }
+};
+
+TEST_F(TBroadcast, Broadcast)
+{
+    CProperty<uint32_t, Access::READ_WRITE> setpoint("setpoint");
+    CProperty<uint32_t, Access::READ>       readonly("setpoint");
+    ErrorCode                               results[DEVICES];
+
+    EXPECT_EQ(readonly.broadcast(client, ADDRESS_BROADCAST, 1), ErrorCode::E_READ_ONLY);
+
+    // 一帧写入所有设备, 不应答
+    ASSERT_EQ(setpoint.broadcast(client, ADDRESS_BROADCAST, 1234), ErrorCode::S_OK);
+    wait(1);
+    EXPECT_TRUE(client.Q_Client.empty());
+    for (auto& device : devices)
+        EXPECT_EQ(device->Setpoint, 1234);
+
+    // 一轮读回验证
+    EXPECT_EQ(setpoint.sweep(client, addresses, DEVICES, 1234, results), DEVICES);
+    for (ErrorCode err : results)
+        EXPECT_EQ(err, ErrorCode::S_OK);
+    EXPECT_EQ(client.address, 0);
+}
+
+TEST_F(TBroadcast, Encrypted)
+{
+    CProperty<uint32_t, Access::WRITE_PROTECT> secure("setpoint");
+
+    // 各设备的随机数不同, 写保护的属性不能广播写入
+    EXPECT_EQ(secure.broadcast(client, ADDRESS_BROADCAST, 1), ErrorCode::E_NO_PERMISSION);
+
+    // 即使密钥和随机数恰好相同, 加密的广播帧也被丢弃, 随机数不变
+    Extra& extra = client.extra;
+    extra.reset();
+    extra.add<PropertyId>(0);
+    extra.add<uint32_t>(1);
+    client.send_to(ADDRESS_BROADCAST, Command::SET_PROPERTY, extra, true);
+    wait(1);
+    EXPECT_TRUE(client.Q_Client.empty());
+    for (auto& device : devices)
+    {
+        EXPECT_EQ(device->Setpoint, 0);
+        EXPECT_EQ(device->Secret.nonce, secret.nonce);
+    }
+}
+
+TEST_F(TBroadcast, Group)
+{
+    CProperty<uint32_t, Access::READ_WRITE> setpoint("setpoint");
+    ErrorCode                               results[DEVICES];
+
+    ASSERT_EQ(setpoint.broadcast(client, 0x80, 42), ErrorCode::S_OK);
+    wait(1);
+    EXPECT_TRUE(client.Q_Client.empty());
+
+    // 只有组 0x80 的设备写入
+    EXPECT_EQ(setpoint.sweep(client, addresses, DEVICES, 42, results), DEVICES / 2);
+    for (size_t i = 0; i < DEVICES; i++)
+        EXPECT_EQ(results[i], i % 2 ? ErrorCode::S_OK : ErrorCode::E_FAIL);
+}
+
+TEST_F(TBroadcast, Silent)
+{
+    Extra     extra;
+    ErrorCode err;
+
+    // 广播的读取和错误的写入都不应答
+    extra.add<PropertyId>(0);
+    client.send_to(ADDRESS_BROADCAST, Command::GET_PROPERTY, extra);
+    extra.reset();
+    extra.add<PropertyId>(100);
+    extra.add<uint32_t>(1);
+    client.send_to(ADDRESS_BROADCAST, Command::SET_PROPERTY, extra);
+    wait(2);
+    EXPECT_TRUE(client.Q_Client.empty());
+
+    // 组播的回声不应答, 其他组和其他地址的帧被跳过
+    extra.reset();
+    client.send_to(0x80, Command::ECHO, extra);
+    extra.reset();
+    client.send_to(0x90, Command::ECHO, extra);
+    client.address = 1;
+    extra.reset();
+    client.send(Command::ECHO, extra);
+    wait(5);
+
+    // 只有单播的回声应答
+    ASSERT_TRUE(client.recv_response(Command::ECHO, err, client.extra));
+    EXPECT_EQ(err, ErrorCode::S_OK);
+    EXPECT_TRUE(client.Q_Client.empty());
+
+    const uint32_t foreign[DEVICES] = {2, 2, 3, 2};
+    for (size_t i = 0; i < DEVICES; i++)
+    {
+        EXPECT_EQ(devices[i]->Server.stats().foreign, foreign[i]);
+        EXPECT_EQ(devices[i]->Server.stats().frames, 5 - foreign[i]);
+    }
+}
+
+TEST_F(TBroadcast, Link)
+{
+    CProperty<uint32_t, Access::READ_WRITE> setpoint("setpoint");
+    ErrorCode                               results[DEVICES];
+
+    // 组播地址的链路参数被忽略, 只有广播使所有设备同时切换
+    Extra extra;
+    extra.add(LinkOption::CHECKSUM);
+    extra.add(ChecksumType::CRC32C);
+    client.send_to(0x80, Command::SET_LINK, extra);
+    client.address = ADDRESS_BROADCAST;
+    // 加密套件须加密设置, 各设备的随机数不同, 不能广播
+    EXPECT_EQ(client.set_link(LinkOption::CIPHER, 0), ErrorCode::E_INVALID_ARG);
+    ASSERT_EQ(client.set_link(LinkOption::CHECKSUM, (uint8_t)ChecksumType::CRC32C), ErrorCode::S_OK);
+    ASSERT_EQ(setpoint.broadcast(client, ADDRESS_BROADCAST, 7), ErrorCode::S_OK);
+    wait(3);
+    EXPECT_TRUE(client.Q_Client.empty());
+
+    // 各设备按相同的校验和长度跳过其他设备的帧
+    EXPECT_EQ(setpoint.sweep(client, addresses, DEVICES, 7, results), DEVICES);
+    for (auto& device : devices)
+    {
+        EXPECT_EQ(device->Server.stats().noise, 0);
+        EXPECT_EQ(device->Server.stats().checksum, 0);
+    }
+
+    // 广播恢复默认值
+    client.address = ADDRESS_BROADCAST;
+    ASSERT_EQ(client.reset_link(), ErrorCode::S_OK);
+    EXPECT_EQ(setpoint.sweep(client, addresses, DEVICES, 7, results), DEVICES);
+}
+
+TEST_F(TBroadcast, Latch)
+{
+    struct Sample
+    {
+        uint32_t setpoint;
+        uint32_t counter;
+    };
+
+    CLatch<Sample> latch("latch");
+    Sample         samples[DEVICES];
+    ErrorCode      results[DEVICES];
+
+    // 所有设备在同一帧锁存, 不应答
+    for (size_t i = 0; i < DEVICES; i++)
+        devices[i]->Counter = i * 10;
+    ASSERT_EQ(latch.trigger(client, ADDRESS_BROADCAST, 7), ErrorCode::S_OK);
+    wait(1);
+    EXPECT_TRUE(client.Q_Client.empty());
+
+    // 锁存之后的修改不影响锁存值
+    for (auto& device : devices)
+        device->Counter = 999;
+    ASSERT_EQ(latch.collect(client, addresses, DEVICES, 7, samples, results), DEVICES);
+    for (size_t i = 0; i < DEVICES; i++)
+    {
+        EXPECT_EQ(results[i], ErrorCode::S_OK);
+        EXPECT_EQ(samples[i].setpoint, 0);
+        EXPECT_EQ(samples[i].counter, i * 10);
+    }
+
+    // 只有组 0x80 的设备锁存, 其他设备的序号不一致
+    ASSERT_EQ(latch.trigger(client, 0x80, 8), ErrorCode::S_OK);
+    wait(1 + DEVICES + 1);
+    EXPECT_EQ(latch.collect(client, addresses, DEVICES, 8, samples, results), DEVICES / 2);
+    for (size_t i = 0; i < DEVICES; i++)
+    {
+        EXPECT_EQ(results[i], i % 2 ? ErrorCode::S_OK : ErrorCode::E_FAIL);
+        if (i % 2)
+        {
+            EXPECT_EQ(samples[i].counter, 999);
+        }
+    }
+
+    // 单播锁存需要应答
+    client.address = 1;
+    EXPECT_EQ(latch.latch(client, 9), ErrorCode::S_OK);
+    EXPECT_EQ(devices[0]->P_Latch.seq(), 9);
+}
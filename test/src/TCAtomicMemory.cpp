@@ -0,0 +1,147 @@
+#include "gtest/gtest.h"
+#include <AtomicMemory.hpp>
+#include <CMemory.hpp>
+#include <future>
+#include <HostCS.hpp>
+
+using ArrayType = std::array<uint8_t, 1024 + 256>;
+
+static ArrayType                                   ArrayVal;
+static AtomicMemory<ArrayType, Access::READ_WRITE> Prop_1(ArrayVal);
+// 静态初始化
+static constexpr PropertyMap<1>                    Map = {
+    {
+     {"prop.1", &(PropertyBase&)Prop_1},
+     }
+};
+static PropertyHolder            Holder(Map);
+
+static constinit CPropertyMap<1> CMap = {
+    {
+     {"prop.1", 0},
+     }
+};
+static CPropertyHolder CHolder(CMap);
+
+struct TCAtomicMemory
+    : public HostCSBase
+    , public testing::Test
+{
+    bool              Running = true;
+    std::future<void> end;
+
+    TCAtomicMemory()
+        : HostCSBase(Holder, CHolder)
+    {
+    }
+
+    virtual void SetUp()
+    {
+        end = std::async(std::launch::async,
+                         [this]()
+                         {
+                             while (Running)
+                             {
+                                 server.poll();
+                             }
+                         });
+    }
+
+    virtual void TearDown()
+    {
+        Running        = false;
+        server.Running = false;
+        end.get();
+    }
+};
+
+TEST_F(TCAtomicMemory, Commit)
+{
+    ArrayType          CArrayVal;
+    CMemory<ArrayType> c_prop("prop.1");
+
+    for (size_t i = 0; i < CArrayVal.size(); i++)
+    {
+        CArrayVal[i] = i;
+    }
+
+    ArrayVal.fill(0xCC);
+
+    EXPECT_EQ(c_prop.begin(client), ErrorCode::S_OK);
+    EXPECT_EQ(c_prop.set(client, 0, CArrayVal.data(), CArrayVal.size()), ErrorCode::S_OK);
+
+    // 提交前属性值保持不变
+    ArrayType Expected;
+    Expected.fill(0xCC);
+    EXPECT_TRUE(memcmp(Expected.data(), ArrayVal.data(), ArrayVal.size()) == 0);
+
+    EXPECT_EQ(c_prop.commit(client, crc_32(CArrayVal.data(), CArrayVal.size())), ErrorCode::S_OK);
+    EXPECT_TRUE(memcmp(CArrayVal.data(), ArrayVal.data(), ArrayVal.size()) == 0);
+}
+
+TEST_F(TCAtomicMemory, Commit_BadCRC)
+{
+    ArrayType          CArrayVal;
+    CMemory<ArrayType> c_prop("prop.1");
+
+    CArrayVal.fill(0x55);
+    ArrayVal.fill(0xCC);
+
+    EXPECT_EQ(c_prop.begin(client), ErrorCode::S_OK);
+    EXPECT_EQ(c_prop.set(client, 0, CArrayVal.data(), CArrayVal.size()), ErrorCode::S_OK);
+    EXPECT_EQ(c_prop.commit(client, 0), ErrorCode::E_FAIL);
+    EXPECT_EQ(ArrayVal[0], 0xCC);
+
+    // 事务已结束
+    EXPECT_EQ(c_prop.commit(client, 0), ErrorCode::E_ILLEGAL_STATE);
+}
+
+TEST_F(TCAtomicMemory, Commit_NoCRC)
+{
+    ArrayType          CArrayVal;
+    CMemory<ArrayType> c_prop("prop.1");
+
+    CArrayVal.fill(0x55);
+    ArrayVal.fill(0xCC);
+
+    EXPECT_EQ(c_prop.begin(client), ErrorCode::S_OK);
+    EXPECT_EQ(c_prop.set(client, 0, CArrayVal.data(), 16), ErrorCode::S_OK);
+    EXPECT_EQ(c_prop.commit(client), ErrorCode::E_INVALID_ARG);
+    EXPECT_EQ(ArrayVal[0], 0xCC);
+
+    // 事务已结束, 之后的写入直接生效
+    EXPECT_EQ(c_prop.set(client, 0, CArrayVal.data(), 16), ErrorCode::S_OK);
+    EXPECT_EQ(ArrayVal[0], 0x55);
+}
+
+TEST_F(TCAtomicMemory, Abort)
+{
+    ArrayType          CArrayVal;
+    CMemory<ArrayType> c_prop("prop.1");
+
+    CArrayVal.fill(0x55);
+    ArrayVal.fill(0xCC);
+
+    EXPECT_EQ(c_prop.begin(client), ErrorCode::S_OK);
+    EXPECT_EQ(c_prop.set(client, 16, CArrayVal.data(), 16), ErrorCode::S_OK);
+    EXPECT_EQ(c_prop.abort(client), ErrorCode::S_OK);
+    EXPECT_EQ(ArrayVal[16], 0xCC);
+
+    // 不在事务中的写入直接生效
+    EXPECT_EQ(c_prop.set(client, 16, CArrayVal.data(), 16), ErrorCode::S_OK);
+    EXPECT_EQ(ArrayVal[16], 0x55);
+}
+
+TEST_F(TCAtomicMemory, SetAtomic)
+{
+    ArrayType          CArrayVal;
+    CMemory<ArrayType> c_prop("prop.1");
+
+    for (size_t i = 0; i < CArrayVal.size(); i++)
+    {
+        CArrayVal[i] = ~i;
+    }
+
+    EXPECT_EQ(c_prop.set_atomic(client, CArrayVal), ErrorCode::S_OK);
+    EXPECT_TRUE(memcmp(CArrayVal.data(), ArrayVal.data(), ArrayVal.size()) == 0);
+}
@@ -0,0 +1,130 @@
+#include "gtest/gtest.h"
+#include <CMemory.hpp>
+#include <FlashSim.hpp>
+#include <future>
+#include <HostCS.hpp>
+
+using ArrayType = std::array<uint8_t, 600>;
+
+static FlashSim<1024, 256>                             Flash;
+// 内存区不与页对齐
+static FlashMemory<ArrayType, 256, Access::READ_WRITE> Prop_1(Flash, 128);
+// 静态初始化
+static constexpr PropertyMap<1>                        Map = {
+    {
+     {"prop.1", &(PropertyBase&)Prop_1},
+     }
+};
+static PropertyHolder            Holder(Map);
+
+static constinit CPropertyMap<1> CMap = {
+    {
+     {"prop.1", 0},
+     }
+};
+static CPropertyHolder CHolder(CMap);
+
+struct TCFlashMemory
+    : public HostCSBase
+    , public testing::Test
+{
+    bool              Running = true;
+    std::future<void> end;
+
+    TCFlashMemory()
+        : HostCSBase(Holder, CHolder)
+    {
+    }
+
+    virtual void SetUp()
+    {
+        Flash.Erased     = 0;
+        Flash.Programmed = 0;
+        Flash.BadPage    = SIZE_MAX;
+
+        end = std::async(std::launch::async,
+                         [this]()
+                         {
+                             while (Running)
+                             {
+                                 server.poll();
+                             }
+                         });
+    }
+
+    virtual void TearDown()
+    {
+        Running        = false;
+        server.Running = false;
+        end.get();
+        // 提交失败的测试遗留的数据
+        Flash.BadPage = SIZE_MAX;
+        Prop_1.flush();
+    }
+};
+
+TEST_F(TCFlashMemory, Set_Coalesce)
+{
+    ArrayType          CArrayVal;
+    CMemory<ArrayType> c_prop("prop.1");
+
+    for (size_t i = 0; i < CArrayVal.size(); i++)
+    {
+        CArrayVal[i] = i;
+    }
+
+    // 使用较小的分块写入
+    client.capability.memory = 64;
+    EXPECT_EQ(c_prop.set(client, 0, CArrayVal.data(), CArrayVal.size()), ErrorCode::S_OK);
+
+    // 只有写满的页才会被提交
+    EXPECT_EQ(Flash.Erased, 2);
+    EXPECT_TRUE(memcmp(CArrayVal.data(), &Flash.Flash[128], 512 - 128) == 0);
+
+    // 未提交的数据也能读回
+    ArrayType CReadVal;
+    EXPECT_EQ(c_prop.get(client, 0, CReadVal.data(), CReadVal.size()), ErrorCode::S_OK);
+    EXPECT_TRUE(memcmp(CArrayVal.data(), CReadVal.data(), CArrayVal.size()) == 0);
+
+    // 提交最后一页
+    EXPECT_EQ(c_prop.commit(client), ErrorCode::S_OK);
+    EXPECT_EQ(Flash.Erased, 3);
+    EXPECT_TRUE(memcmp(CArrayVal.data(), &Flash.Flash[128], CArrayVal.size()) == 0);
+
+    // 内存区以外的数据保持不变
+    EXPECT_EQ(Flash.Flash[127], 0xFF);
+    EXPECT_EQ(Flash.Flash[128 + CArrayVal.size()], 0xFF);
+
+    // 没有未提交的数据时不会再次写入
+    EXPECT_EQ(c_prop.commit(client), ErrorCode::S_OK);
+    EXPECT_EQ(Flash.Erased, 3);
+}
+
+TEST_F(TCFlashMemory, Set_BadBlock)
+{
+    ArrayType          CArrayVal;
+    CMemory<ArrayType> c_prop("prop.1");
+
+    CArrayVal.fill(0x55);
+    Flash.BadPage = 512;
+
+    EXPECT_EQ(c_prop.set(client, 0, CArrayVal.data(), CArrayVal.size()), ErrorCode::S_OK);
+    EXPECT_EQ(c_prop.commit(client), ErrorCode::E_BAD_BLOCK);
+}
+
+TEST_F(TCFlashMemory, Verify)
+{
+    ArrayType          CArrayVal;
+    CMemory<ArrayType> c_prop("prop.1");
+
+    for (size_t i = 0; i < CArrayVal.size(); i++)
+    {
+        CArrayVal[i] = ~i;
+    }
+
+    EXPECT_EQ(c_prop.set(client, 0, CArrayVal.data(), CArrayVal.size()), ErrorCode::S_OK);
+    // 包含未提交的数据
+    EXPECT_EQ(c_prop.verify(client, 0, CArrayVal.data(), CArrayVal.size()), ErrorCode::S_OK);
+    EXPECT_EQ(c_prop.commit(client), ErrorCode::S_OK);
+    EXPECT_EQ(c_prop.verify(client, 0, CArrayVal.data(), CArrayVal.size(), CrcType::CRC64), ErrorCode::S_OK);
+}
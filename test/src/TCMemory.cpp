@@ -82,4 +82,83 @@ TEST_F(TCMemory, Get)
 
     EXPECT_EQ(c_prop.get(client, 64, CArrayVal.data(), CArrayVal.size()), ErrorCode::S_OK);
     EXPECT_TRUE(memcmp(CArrayVal.data(), &ArrayVal[64], CArrayVal.size()) == 0);
-}
\ No newline at end of file
+}
+TEST_F(TCMemory, Negotiate)
+{
+    EXPECT_EQ(client.negotiate(), ErrorCode::S_OK);
+    EXPECT_EQ(client.memory_access_size(), MEMORY_ACCESS_SIZE_MAX);
+
+    // 模拟缓冲区较小的 Server
+    client.capability.memory = 100;
+    EXPECT_EQ(client.memory_access_size(), 100);
+
+    std::array<uint8_t, 1024 + 256> CArrayVal;
+    CMemory<decltype(CArrayVal)>    c_prop("prop.1");
+
+    for (size_t i = 0; i < CArrayVal.size(); i++)
+    {
+        CArrayVal[i] = i;
+    }
+
+    memset(ArrayVal.data(), 0xCC, ArrayVal.size());
+
+    EXPECT_EQ(c_prop.set(client, 64, CArrayVal.data(), CArrayVal.size()), ErrorCode::S_OK);
+    EXPECT_TRUE(memcmp(CArrayVal.data(), &ArrayVal[64], CArrayVal.size()) == 0);
+
+    memset(CArrayVal.data(), 0xCC, CArrayVal.size());
+
+    EXPECT_EQ(c_prop.get(client, 64, CArrayVal.data(), CArrayVal.size()), ErrorCode::S_OK);
+    EXPECT_TRUE(memcmp(CArrayVal.data(), &ArrayVal[64], CArrayVal.size()) == 0);
+}
+
+TEST_F(TCMemory, Verify)
+{
+    std::array<uint8_t, 1024 + 256> CArrayVal;
+    CMemory<decltype(CArrayVal)>    c_prop("prop.1");
+
+    for (size_t i = 0; i < ArrayVal.size(); i++)
+    {
+        ArrayVal[i] = i * 7;
+    }
+    memcpy(CArrayVal.data(), &ArrayVal[64], CArrayVal.size());
+
+    EXPECT_EQ(c_prop.verify(client, 64, CArrayVal.data(), CArrayVal.size()), ErrorCode::S_OK);
+    EXPECT_EQ(c_prop.verify(client, 64, CArrayVal.data(), CArrayVal.size(), CrcType::CRC64), ErrorCode::S_OK);
+
+    // 数据不一致
+    ArrayVal[1000]++;
+    EXPECT_EQ(c_prop.verify(client, 64, CArrayVal.data(), CArrayVal.size()), ErrorCode::E_FAIL);
+    EXPECT_EQ(c_prop.verify(client, 64, CArrayVal.data(), CArrayVal.size(), CrcType::CRC64), ErrorCode::E_FAIL);
+
+    // 越界访问
+    EXPECT_EQ(c_prop.verify(client, ArrayVal.size(), CArrayVal.data(), 1), ErrorCode::E_OUT_OF_INDEX);
+}
+
+TEST_F(TCMemory, Link_CRC32C)
+{
+    EXPECT_EQ(client.negotiate(), ErrorCode::S_OK);
+    EXPECT_TRUE(client.capability.has(Feature::CRC32C));
+    EXPECT_EQ(client.set_link(LinkOption::CHECKSUM, (uint8_t)ChecksumType::CRC32C), ErrorCode::S_OK);
+
+    std::array<uint8_t, 1024 + 256> CArrayVal;
+    CMemory<decltype(CArrayVal)>    c_prop("prop.1");
+
+    for (size_t i = 0; i < CArrayVal.size(); i++)
+    {
+        CArrayVal[i] = i;
+    }
+
+    EXPECT_EQ(c_prop.set(client, 64, CArrayVal.data(), CArrayVal.size()), ErrorCode::S_OK);
+    EXPECT_TRUE(memcmp(CArrayVal.data(), &ArrayVal[64], CArrayVal.size()) == 0);
+
+    memset(CArrayVal.data(), 0xCC, CArrayVal.size());
+    EXPECT_EQ(c_prop.get(client, 64, CArrayVal.data(), CArrayVal.size()), ErrorCode::S_OK);
+    EXPECT_TRUE(memcmp(CArrayVal.data(), &ArrayVal[64], CArrayVal.size()) == 0);
+
+    // 无效参数
+    EXPECT_EQ(client.set_link(LinkOption::CHECKSUM, 0xFF), ErrorCode::E_INVALID_ARG);
+
+    // 恢复默认值
+    EXPECT_EQ(client.reset_link(), ErrorCode::S_OK);
+    EXPECT_EQ(c_prop.get(client, 64, CArrayVal.data(), CArrayVal.size()), ErrorCode::S_OK);
+}
@@ -0,0 +1,112 @@
+#include "gtest/gtest.h"
+#include <ConstProperty.hpp>
+#include <CProperty.hpp>
+#include <future>
+#include <HostCS.hpp>
+
+static constexpr uint8_t Check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+static_assert(crc16_ccitt(Check, sizeof(Check)) == 0x29B1);
+
+// 编译期生成应答帧, 存放在只读存储区
+static constexpr ConstProperty   Version("v1.2.3", 0);
+static constexpr ConstProperty   Magic(0xDEADBEEFu, 0);
+// 地址与本机不一致, 按普通属性应答
+static constexpr ConstProperty   Other((uint16_t)0x1234, 5);
+// 静态初始化
+static constexpr PropertyMap<3>  Map = {
+    {
+     {"version", (PropertyBase*)&Version},
+     {"magic", (PropertyBase*)&Magic},
+     {"other", (PropertyBase*)&Other},
+     }
+};
+static PropertyHolder            Holder(Map);
+
+static constinit CPropertyMap<3> CMap = {
+    {
+     {"version", 0},
+     {"magic", 1},
+     {"other", 2},
+     }
+};
+static CPropertyHolder CHolder(CMap);
+
+TEST(ConstProperty, Frame)
+{
+    const uint8_t* frame;
+    size_t         size;
+
+    static_assert(sizeof(Version) == sizeof(void*) + decltype(Version)::FRAME + 1);
+    ASSERT_EQ(Version.get_frame(0, frame, size), ErrorCode::S_OK);
+    ASSERT_EQ(size, sizeof(Header) + sizeof(Checksum) + 6 + sizeof(Checksum));
+    EXPECT_EQ(memcmp(&frame[7], "v1.2.3", 6), 0);
+
+    // 与运行时 HostBase::send 计算的校验和一致
+    EXPECT_EQ(crc_ccitt_ffff(frame, sizeof(Header)), (frame[5] << 8) | frame[6]);
+    EXPECT_EQ(crc_ccitt_ffff(&frame[7], 6), (frame[13] << 8) | frame[14]);
+    EXPECT_EQ(crc_ccitt_ffff(frame, 7), 0);
+    EXPECT_EQ(crc_ccitt_ffff(&frame[7], 8), 0);
+
+    EXPECT_EQ(Version.get_frame(1, frame, size), ErrorCode::E_NO_IMPLEMENT);
+}
+
+struct TConstProperty
+    : public HostCSBase
+    , public testing::Test
+{
+    bool              Running = true;
+    std::future<void> end;
+
+    TConstProperty()
+        : HostCSBase(Holder, CHolder)
+    {
+    }
+
+    virtual void SetUp()
+    {
+        end = std::async(std::launch::async,
+                         [this]()
+                         {
+                             while (Running)
+                             {
+                                 server.poll();
+                             }
+                         });
+    }
+
+    virtual void TearDown()
+    {
+        Running        = false;
+        server.Running = false;
+        end.get();
+    }
+};
+
+TEST_F(TConstProperty, Get)
+{
+    CProperty<std::array<char, 6>, Access::READ> c_version("version");
+    CProperty<uint32_t, Access::READ>            c_magic("magic");
+    CProperty<uint16_t, Access::READ>            c_other("other");
+    std::array<char, 6>                          version;
+    uint32_t                                     magic;
+    uint16_t                                     other;
+
+    // 应答帧以一次 tx 发送
+    ASSERT_EQ(c_magic.get(client, magic), ErrorCode::S_OK);
+    EXPECT_EQ(magic, 0xDEADBEEF);
+    EXPECT_EQ(server.TxCalls, 1);
+
+    ASSERT_EQ(c_version.get(client, version), ErrorCode::S_OK);
+    EXPECT_EQ(memcmp(version.data(), "v1.2.3", 6), 0);
+    EXPECT_EQ(server.TxCalls, 2);
+
+    ASSERT_EQ(c_other.get(client, other), ErrorCode::S_OK);
+    EXPECT_EQ(other, 0x1234);
+    EXPECT_GT(server.TxCalls, 3);
+
+    // CRC32C 链路按普通属性应答
+    ASSERT_EQ(client.set_link(LinkOption::CHECKSUM, (uint8_t)ChecksumType::CRC32C), ErrorCode::S_OK);
+    ASSERT_EQ(c_magic.get(client, magic), ErrorCode::S_OK);
+    EXPECT_EQ(magic, 0xDEADBEEF);
+    ASSERT_EQ(client.reset_link(), ErrorCode::S_OK);
+}
@@ -0,0 +1,56 @@
+#include "gtest/gtest.h"
+#include <array>
+#include <Crc.hpp>
+#include <Crc32c.hpp>
+
+TEST(Crc, CRC32)
+{
+    const uint8_t data[] = "123456789";
+
+    Crc crc(CrcType::CRC32);
+    crc.update(data, 4);
+    crc.update(data + 4, 5);
+    EXPECT_EQ(crc.value(), 0xCBF43926);
+    EXPECT_EQ(crc.value(), crc_32(data, 9));
+}
+
+TEST(Crc, CRC64)
+{
+    const uint8_t data[] = "123456789";
+
+    Crc crc(CrcType::CRC64);
+    crc.update(data, 4);
+    crc.update(data + 4, 5);
+    EXPECT_EQ(crc.value(), 0x6C40DF5F0B497347);
+    EXPECT_EQ(crc.value(), crc_64_ecma(data, 9));
+}
+
+TEST(Crc32c, Check)
+{
+    const uint8_t data[] = "123456789";
+
+    EXPECT_EQ(crc32c(0, data, 9), 0xE3069283);
+    EXPECT_EQ(crc32c_sw(0, data, 9), 0xE3069283);
+    // 分段计算
+    EXPECT_EQ(crc32c(crc32c(0, data, 4), data + 4, 5), 0xE3069283);
+}
+
+TEST(Crc32c, Hardware)
+{
+    if (!crc32c_hw_supported()) GTEST_SKIP();
+
+    std::array<uint8_t, 1024 + 7> data;
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = i * 31 + 7;
+    }
+
+    // 覆盖各种长度与对齐
+    for (size_t offset = 0; offset < 8; offset++)
+    {
+        for (size_t size = 0; size < data.size() - offset; size += 13)
+        {
+            ASSERT_EQ(crc32c_hw(0, &data[offset], size), crc32c_sw(0, &data[offset], size));
+        }
+    }
+}
@@ -0,0 +1,233 @@
+#include "gtest/gtest.h"
+#include <CDiscovery.hpp>
+#include <deque>
+#include <HostCS.hpp>
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+
+static uint32_t                Value;
+static Property<uint32_t>      Prop(Value);
+static constexpr PropertyMap<1> Map = {
+    {
+     {"value", &(PropertyBase&)Prop},
+     }
+};
+static PropertyHolder            Holder(Map);
+
+static constinit CPropertyMap<1> CMap = {
+    {
+     {"value", 0},
+     }
+};
+static CPropertyHolder CHolder(CMap);
+
+/**
+ * @brief 总线上的设备, 出厂地址都为 0
+ *
+ */
+struct SlotDevice : public HostServer
+{
+    Address              address = 0;
+    UniqueId             Uid;
+    SecretHolderImpl     Secret;
+    std::deque<uint8_t>  In;
+    std::vector<uint8_t> Out;
+    uint8_t              Slot = 0;
+
+    SlotDevice(const UniqueId& uid)
+        : HostServer(address, Holder, Secret)
+        , Uid(uid)
+    {
+        set_uid(&Uid);
+    }
+
+    virtual bool rx(uint8_t& byte) override
+    {
+        if (In.empty()) return false;
+        byte = In.front();
+        In.pop_front();
+        return true;
+    }
+
+    virtual void tx(const void* buf, size_t size) override
+    {
+        Out.insert(Out.end(), (const uint8_t*)buf, (const uint8_t*)buf + size);
+    }
+
+    virtual void wait_slot(uint8_t slot, uint16_t) override
+    {
+        Slot = slot;
+    }
+};
+
+/**
+ * @brief 按时隙排列应答的总线, 同一时隙的应答叠加(线与), 模拟冲突
+ *
+ * @note 一帧由多次 tx 发送, 请求在 Client 开始接收时才交给设备处理
+ */
+struct SlotBus : public HostClient
+{
+    Address                  address = 0;
+    std::vector<SlotDevice*> Devices;
+    std::vector<uint8_t>     Pending;
+    std::deque<uint8_t>      In;
+
+    SlotBus(SecretHolder& secret)
+        : HostClient(address, CHolder, secret)
+    {
+    }
+
+    virtual bool rx(uint8_t& byte) override
+    {
+        if (!Pending.empty()) deliver();
+        // 没有数据即为接收超时
+        if (In.empty()) return false;
+        byte = In.front();
+        In.pop_front();
+        return true;
+    }
+
+    virtual void tx(const void* buf, size_t size) override
+    {
+        Pending.insert(Pending.end(), (const uint8_t*)buf, (const uint8_t*)buf + size);
+    }
+
+    virtual void log_output(LogLevel, const uint8_t*, size_t) override
+    {
+    }
+
+    void deliver()
+    {
+        std::map<uint8_t, std::vector<uint8_t>> slots;
+        for (SlotDevice* device : Devices)
+        {
+            device->In.insert(device->In.end(), Pending.begin(), Pending.end());
+            device->Out.clear();
+            device->Slot = 0;
+            while (!device->In.empty())
+                device->poll();
+            if (device->Out.empty()) continue;
+
+            auto& line = slots[device->Slot];
+            if (line.size() < device->Out.size()) line.resize(device->Out.size(), 0xFF);
+            for (size_t i = 0; i < device->Out.size(); i++)
+                line[i] &= device->Out[i];
+        }
+        Pending.clear();
+        for (auto& [slot, line] : slots)
+            In.insert(In.end(), line.begin(), line.end());
+    }
+};
+
+TEST(Discovery, Request)
+{
+    DiscoverRequest req = {};
+    UniqueId        uid = {0xA5, 0x0F};
+
+    // 空前缀匹配所有设备
+    EXPECT_TRUE(req.match(uid));
+    req.prefix = {0xA0};
+    req.bits   = 4;
+    EXPECT_TRUE(req.match(uid));
+    req.bits = 6;
+    EXPECT_FALSE(req.match(uid));
+    req.prefix = uid;
+    req.bits   = 96;
+    EXPECT_TRUE(req.match(uid));
+    req.bits = 97;
+    EXPECT_FALSE(req.match(uid));
+
+    // 时隙由种子和唯一Id决定
+    req.slots = 1;
+    EXPECT_EQ(req.slot(uid), 0);
+    req.slots = 16;
+    bool varies = false;
+    for (req.seed = 0; req.seed < 16; req.seed++)
+    {
+        EXPECT_LT(req.slot(uid), 16);
+        varies |= req.slot(uid) != req.slot(UniqueId {});
+    }
+    EXPECT_TRUE(varies);
+}
+
+struct TDiscovery : public testing::Test
+{
+    SecretHolderImpl                         secret;
+    SlotBus                                  client {secret};
+    std::vector<std::unique_ptr<SlotDevice>> devices;
+    CDiscovery<64>                           discovery;
+
+    void add(const UniqueId& uid)
+    {
+        devices.push_back(std::make_unique<SlotDevice>(uid));
+        client.Devices.push_back(devices.back().get());
+    }
+
+    // 每个设备的地址都与发现结果一致且互不相同
+    void verify()
+    {
+        ASSERT_EQ(discovery.size(), devices.size());
+        std::set<Address> used;
+        for (size_t i = 0; i < discovery.size(); i++)
+        {
+            auto it = std::find_if(devices.begin(), devices.end(),
+                                   [&](auto& device) { return device->Uid == discovery.uid(i); });
+            ASSERT_NE(it, devices.end());
+            EXPECT_EQ((*it)->address, discovery.address(i));
+            EXPECT_TRUE(used.insert(discovery.address(i)).second);
+        }
+    }
+};
+
+TEST_F(TDiscovery, Line)
+{
+    std::mt19937 rng(1);
+    for (size_t i = 0; i < 32; i++)
+    {
+        UniqueId uid;
+        for (auto& byte : uid)
+            byte = rng();
+        add(uid);
+    }
+
+    ASSERT_EQ(discovery.discover(client, 1), ErrorCode::S_OK);
+    verify();
+    EXPECT_EQ(client.address, 0);
+    // 远少于逐个探测 254 个地址
+    EXPECT_LT(discovery.queries(), 64);
+
+    // 再次发现时重新分配
+    ASSERT_EQ(discovery.discover(client, 100), ErrorCode::S_OK);
+    verify();
+    EXPECT_EQ(discovery.address(0), 100);
+}
+
+TEST_F(TDiscovery, Collision)
+{
+    // 唯一Id只有最后一位不同, 不使用时隙时需要查找到最后一位
+    UniqueId uid = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+    add(uid);
+    uid[11] ^= 1;
+    add(uid);
+    uid[0] ^= 0x80;
+    add(uid);
+
+    discovery.slots = 1;
+    ASSERT_EQ(discovery.discover(client, 1), ErrorCode::S_OK);
+    verify();
+    EXPECT_GT(client.stats().checksum + client.stats().noise, 0);
+}
+
+TEST_F(TDiscovery, Capacity)
+{
+    CDiscovery<2> small;
+    for (uint8_t i = 0; i < 3; i++)
+        add({i});
+
+    small.slots = 8;
+    EXPECT_EQ(small.discover(client, 1), ErrorCode::E_OUT_OF_BUFFER);
+    EXPECT_EQ(small.size(), 2);
+    EXPECT_TRUE(client.In.empty());
+}
@@ -74,3 +74,49 @@ TEST(Extra, AES)
         ASSERT_EQ(val, 0x01);
     }
 }
+
+TEST(Extra, CipherSuite)
+{
+    KeyType   key;
+    NonceType nonce;
+    for (size_t i = 0; i < key.size(); i++)
+        key[i] = i;
+    for (size_t i = 0; i < nonce.size(); i++)
+        nonce[i] = 0x80 + i;
+
+    // 非法的编码
+    CipherSuite suite;
+    EXPECT_FALSE(CipherSuite::decode(0x0C, suite));
+    EXPECT_FALSE(CipherSuite::decode(0x10, suite));
+
+    for (uint8_t value = 0; value < 0x0C; value++)
+    {
+        ASSERT_TRUE(CipherSuite::decode(value, suite));
+        ASSERT_EQ(suite.encode(), value);
+
+        Extra extra;
+        extra.add<float>(1.5f);
+        extra.encrypt(nonce, key, suite);
+
+        ASSERT_TRUE(extra.decrypt(nonce, key, suite));
+        extra.seek(0);
+        float val;
+        ASSERT_TRUE(extra.get(val));
+        EXPECT_EQ(val, 1.5f);
+
+        // 篡改 tag 后解密失败
+        extra.reset();
+        extra.add<float>(1.5f);
+        extra.encrypt(nonce, key, suite);
+        extra.tag(suite.tag_size())[0] ^= 0x01;
+        EXPECT_FALSE(extra.decrypt(nonce, key, suite));
+    }
+
+    // 不同套件的密文互不通用
+    CipherSuite ccm;
+    CipherSuite gcm = {CipherMode::GCM, CipherKey::AES256, CipherTag::TAG16};
+    Extra       extra;
+    extra.add<uint32_t>(0x12345678);
+    extra.encrypt(nonce, key, gcm);
+    EXPECT_FALSE(extra.decrypt(nonce, key, ccm));
+}
@@ -0,0 +1,231 @@
+#include "gtest/gtest.h"
+#include <Fault.hpp>
+#include <HostBase.hpp>
+#include <stdio.h>
+
+struct SecretHolderFault : public SecretHolder
+{
+    virtual void update_nonce() override
+    {
+    }
+};
+
+/**
+ * @brief 从内存读取字节流, 发送的数据追加到内存
+ *
+ */
+struct StreamHost : public HostBase
+{
+    Address              address = 1;
+    std::vector<uint8_t> In;
+    size_t               Pos     = 0;
+    std::vector<uint8_t> Out;
+
+    StreamHost(SecretHolder& secret)
+        : HostBase(address, secret)
+    {
+    }
+
+  protected:
+    virtual bool rx(uint8_t& byte) override
+    {
+        if (Pos >= In.size()) return false;
+        byte = In[Pos++];
+        return true;
+    }
+
+    virtual void tx(const void* buf, size_t size) override
+    {
+        Out.insert(Out.end(), (const uint8_t*)buf, (const uint8_t*)buf + size);
+    }
+};
+
+// 每帧附加参数的长度
+static constexpr size_t   PAYLOAD = 32;
+// 折算停顿时间的波特率
+static constexpr uint32_t BAUD    = 115200;
+
+struct BenchResult
+{
+    size_t Sent      = 0;
+    size_t Delivered = 0;
+    size_t False     = 0;
+    // 丢帧后重新同步多消耗的字节数
+    size_t ResyncSum = 0;
+    size_t Resyncs   = 0;
+    size_t LinkBytes = 0;
+
+    double goodput() const
+    {
+        return LinkBytes ? (double)Delivered * PAYLOAD / LinkBytes : 0;
+    }
+
+    double resync_bytes() const
+    {
+        return Resyncs ? (double)ResyncSum / Resyncs : 0;
+    }
+};
+
+static uint8_t pattern(uint32_t seq, size_t i)
+{
+    return (uint8_t)(seq * 31 + i * 7);
+}
+
+/**
+ * @brief 发送 frames 帧, 经故障注入后接收, 统计有效吞吐和重新同步的代价
+ *
+ */
+static BenchResult bench(const FaultConfig& fault, size_t frames, ChecksumType checksum)
+{
+    SecretHolderFault          secret;
+    StreamHost                 sender(secret);
+    FaultTransport<StreamHost> receiver(fault, FaultConfig(), secret);
+    BenchResult                result;
+
+    sender.apply_link(LinkOption::CHECKSUM, (uint8_t)checksum);
+    receiver.apply_link(LinkOption::CHECKSUM, (uint8_t)checksum);
+
+    Extra  extra;
+    size_t frame_size = 0;
+    for (uint32_t seq = 0; seq < frames; seq++)
+    {
+        size_t begin = sender.Out.size();
+        extra.reset();
+        extra.add(seq);
+        for (size_t i = sizeof(seq); i < PAYLOAD; i++)
+            extra.add(pattern(seq, i));
+        sender.send(Command::GET_PROPERTY, extra);
+        frame_size = sender.Out.size() - begin;
+    }
+    receiver.In = sender.Out;
+    result.Sent = frames;
+
+    Command   cmd;
+    ErrorCode err;
+    int64_t   last     = -1;
+    size_t    last_pos = 0;
+    while (receiver.recv(cmd, err, extra))
+    {
+        uint32_t seq;
+        bool     intact = cmd == Command::GET_PROPERTY && extra.remain() == PAYLOAD && extra.get(seq) && seq < frames;
+        for (size_t i = sizeof(seq); intact && i < PAYLOAD; i++)
+        {
+            uint8_t byte;
+            intact = extra.get(byte) && byte == pattern(seq, i);
+        }
+        if (!intact)
+        {
+            // 校验和通过但内容有误
+            result.False++;
+            continue;
+        }
+
+        result.Delivered++;
+        if ((int64_t)seq > last + 1)
+        {
+            // 两个有效帧之间链路上多消耗的字节数
+            result.ResyncSum += receiver.Pos - last_pos - frame_size;
+            result.Resyncs++;
+        }
+        last     = seq;
+        last_pos = receiver.Pos;
+    }
+    result.LinkBytes = receiver.In.size();
+    return result;
+}
+
+TEST(Fault, Inject)
+{
+    FaultConfig config;
+    config.Flip      = 1e-3;
+    config.Drop      = 1e-2;
+    config.Duplicate = 1e-2;
+    config.Stall     = 1e-3;
+    config.StallUs   = 10;
+    FaultInjector        fault(config);
+    std::vector<uint8_t> in(1 << 16, 0);
+    std::vector<uint8_t> out;
+
+    uint32_t stall = fault.apply(in.data(), in.size(), out);
+    size_t   flips = 0;
+    for (uint8_t byte : out)
+        flips += __builtin_popcount(byte);
+
+    // 期望值的 ±20% 以内
+    EXPECT_NEAR(fault.Stats.Drops, in.size() * config.Drop, in.size() * config.Drop * 0.2);
+    EXPECT_NEAR(fault.Stats.Duplicates, in.size() * config.Duplicate, in.size() * config.Duplicate * 0.2);
+    EXPECT_NEAR(fault.Stats.Flips, in.size() * 8 * config.Flip, in.size() * 8 * config.Flip * 0.2);
+    EXPECT_EQ(out.size(), in.size() - fault.Stats.Drops + fault.Stats.Duplicates);
+    EXPECT_EQ(stall, fault.Stats.Stalls * config.StallUs);
+    // 重复的字节携带相同的翻转
+    EXPECT_GE(flips, fault.Stats.Flips);
+
+    // 无故障时原样保留
+    FaultInjector clean(FaultConfig {});
+    out.clear();
+    EXPECT_EQ(clean.apply(in.data(), in.size(), out), 0);
+    EXPECT_EQ(out, in);
+}
+
+TEST(Fault, FalseSync)
+{
+    // 随机字节流中通过帧头校验的概率, 理论值为 2^-16
+    std::mt19937 rng(1);
+    Sync<Header> sync;
+    size_t       bytes = 1 << 22;
+    size_t       hits  = 0;
+    for (size_t i = 0; i < bytes; i++)
+    {
+        sync.push((uint8_t)rng());
+        if (sync.verify())
+        {
+            hits++;
+            sync.get();
+        }
+    }
+    printf("false sync %zu in %zu random bytes, %.2e per byte (expect %.2e)\n", hits, bytes, (double)hits / bytes,
+           1.0 / 65536);
+    EXPECT_GT(hits, bytes / 65536 / 2);
+    EXPECT_LT(hits, bytes / 65536 * 2);
+}
+
+TEST(Fault, Goodput)
+{
+    const double bers[] = {0, 1e-6, 1e-5, 1e-4, 1e-3, 3e-3};
+    const size_t frames = 20000;
+
+    for (ChecksumType checksum : {ChecksumType::CRC16, ChecksumType::CRC32C})
+    {
+        printf("%s, %zu byte payload\n", checksum == ChecksumType::CRC16 ? "CRC16" : "CRC32C", PAYLOAD);
+        printf("%8s %10s %8s %8s %12s %12s\n", "ber", "delivered", "false", "goodput", "resync(B)", "resync(ms)");
+
+        double prev = 1;
+        for (double ber : bers)
+        {
+            FaultConfig fault;
+            fault.Flip         = ber;
+            BenchResult result = bench(fault, frames, checksum);
+            printf("%8.0e %9.3f%% %8zu %8.3f %12.1f %12.3f\n", ber, 100.0 * result.Delivered / result.Sent,
+                   result.False, result.goodput(), result.resync_bytes(), result.resync_bytes() * 10 * 1000 / BAUD);
+
+            if (ber == 0)
+            {
+                EXPECT_EQ(result.Delivered, frames);
+                EXPECT_EQ(result.False, 0);
+                EXPECT_EQ(result.Resyncs, 0);
+            }
+            EXPECT_LE(result.goodput(), prev);
+            prev = result.goodput();
+        }
+    }
+
+    // 丢失和重复的字节使帧长出错, 只能依靠校验和发现
+    FaultConfig fault;
+    fault.Drop         = 1e-4;
+    fault.Duplicate    = 1e-4;
+    BenchResult result = bench(fault, frames, ChecksumType::CRC16);
+    printf("drop/duplicate 1e-4: delivered %.3f%%, false %zu, resync %.1f B\n", 100.0 * result.Delivered / result.Sent,
+           result.False, result.resync_bytes());
+    EXPECT_LT(result.Delivered, frames);
+    EXPECT_GT(result.Resyncs, 0);
+}
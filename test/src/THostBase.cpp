@@ -36,9 +36,39 @@ struct HostBaseImpl : public HostBase
     }
 };
 
+struct HostStream : public HostBase
+{
+    Address              address = 1;
+    SecretHolderImpl     secret;
+    std::vector<uint8_t> In;
+    size_t               Pos     = 0;
+    std::vector<uint8_t> Out;
+
+    HostStream()
+        : HostBase(address, secret)
+    {
+    }
+
+    using HostBase::send;
+
+    virtual bool rx(uint8_t& byte) override
+    {
+        if (Pos >= In.size()) return false;
+        byte = In[Pos++];
+        return true;
+    }
+
+    virtual void tx(const void* buf, const size_t size) override
+    {
+        Out.insert(Out.end(), (const uint8_t*)buf, (const uint8_t*)buf + size);
+    }
+};
+
 TEST(HostBase, sizeof)
 {
-    ASSERT_EQ(sizeof(HostBase), 28);
+    // 虚表指针 + 3 个引用 + 帧头缓冲区(16) + 链路参数和目标地址(5, 补齐到 8) + 接收统计(24)
+    // 固件的 RAM 预算依赖此值, 增加成员时同步修改
+    EXPECT_EQ(sizeof(HostBase), 4 * sizeof(void*) + 48);
 }
 
 TEST(HostBase, TxRx)
@@ -106,4 +136,124 @@ TEST(Sync, Sync)
 
     // 队列在获取帧头后应当被清空
     ASSERT_EQ(Q.size(), 0);
-}
\ No newline at end of file
+}
+TEST(HostBase, Foreign)
+{
+    HostStream sender;
+    HostStream receiver;
+    Extra      extra;
+    Command    cmd;
+    ErrorCode  err;
+
+    // 发给其他地址的明文帧, 加密帧和空帧
+    sender.address = 2;
+    extra.reset();
+    for (uint8_t i = 0; i < 100; i++)
+        extra.add(i);
+    sender.send(Command::SET_PROPERTY, extra);
+    extra.reset();
+    extra.add<uint32_t>(0x12345678);
+    sender.send(Command::SET_PROPERTY, extra, true);
+    extra.reset();
+    sender.send(Command::ECHO, extra);
+    size_t foreign = sender.Out.size();
+
+    sender.address = 1;
+    extra.reset();
+    extra.add<uint16_t>(0xABCD);
+    sender.send(Command::GET_PROPERTY, extra);
+
+    receiver.In = sender.Out;
+    ASSERT_TRUE(receiver.recv(cmd, err, extra));
+    EXPECT_EQ(cmd, Command::GET_PROPERTY);
+    uint16_t value;
+    ASSERT_TRUE(extra.get(value));
+    EXPECT_EQ(value, 0xABCD);
+
+    // 跳过的字节不含 3 个帧头
+    EXPECT_EQ(receiver.stats().foreign, 3);
+    EXPECT_EQ(receiver.stats().skipped, foreign - 3 * (sizeof(Header) + sizeof(Checksum)));
+    EXPECT_EQ(receiver.stats().frames, 1);
+    EXPECT_EQ(receiver.Pos, receiver.In.size());
+}
+
+TEST(HostBase, Oversize)
+{
+    HostStream           sender;
+    HostStream           receiver;
+    Extra                extra;
+    Command              cmd;
+    ErrorCode            err;
+    std::vector<uint8_t> payload(extra.capacity() + 1, 0x55);
+
+    Header head;
+    head.address = 1;
+    head.cmd     = Command::SET_PROPERTY;
+    head.error   = ErrorCode::S_OK;
+    head.size    = payload.size();
+    sender.send(head, payload.data(), payload.size());
+    extra.reset();
+    sender.send(Command::ECHO, extra);
+
+    // 超长的帧被整帧跳过, 不会将附加参数误认为帧头
+    receiver.In = sender.Out;
+    ASSERT_TRUE(receiver.recv(cmd, err, extra));
+    EXPECT_EQ(cmd, Command::SET_PROPERTY);
+    EXPECT_EQ(err, ErrorCode::E_OUT_OF_BUFFER);
+    EXPECT_EQ(extra.size(), 0);
+    EXPECT_EQ(receiver.stats().oversize, 1);
+
+    ASSERT_TRUE(receiver.recv(cmd, err, extra));
+    EXPECT_EQ(cmd, Command::ECHO);
+    EXPECT_EQ(err, ErrorCode::S_OK);
+    EXPECT_EQ(receiver.stats().checksum, 0);
+}
+
+TEST(HostBase, Cipher)
+{
+    HostStream  sender;
+    HostStream  receiver;
+    Extra       extra;
+    Command     cmd;
+    ErrorCode   err;
+    CipherSuite suite = {CipherMode::CCM, CipherKey::AES128, CipherTag::TAG8};
+    CipherSuite gcm   = {CipherMode::GCM, CipherKey::AES256, CipherTag::TAG16};
+
+    ASSERT_EQ(sender.check_link(LinkOption::CIPHER, 0xFF), ErrorCode::E_INVALID_ARG);
+    // 请求与应答共用随机数, 不提供 GCM
+    ASSERT_EQ(sender.check_link(LinkOption::CIPHER, gcm.encode()), ErrorCode::E_NO_IMPLEMENT);
+    ASSERT_EQ(sender.check_link(LinkOption::CIPHER, suite.encode()), ErrorCode::S_OK);
+    sender.apply_link(LinkOption::CIPHER, suite.encode());
+    receiver.apply_link(LinkOption::CIPHER, suite.encode());
+    EXPECT_EQ(sender.cipher().tag_size(), 8);
+    // 双方使用相同的密钥和随机数
+    sender.secret.key     = {1, 2, 3};
+    sender.secret.nonce   = {4, 5, 6};
+    receiver.secret.key   = sender.secret.key;
+    receiver.secret.nonce = sender.secret.nonce;
+
+    // 帧头 + 8 字节 tag + 属性Id + 属性值 + 校验和
+    extra.add<PropertyId>(1);
+    extra.add<float>(2.5f);
+    sender.send(Command::SET_PROPERTY, extra, true);
+    ASSERT_EQ(sender.Out.size(), sizeof(Header) + sizeof(Checksum) + 8 + 6 + sizeof(Checksum));
+
+    receiver.In = sender.Out;
+    ASSERT_TRUE(receiver.recv(cmd, err, extra));
+    EXPECT_EQ(cmd, Command::SET_PROPERTY);
+    ASSERT_TRUE(extra.decrypt(receiver.secret.nonce, receiver.secret.key, receiver.cipher()));
+    PropertyId id;
+    float      value;
+    ASSERT_TRUE(extra.get(id));
+    ASSERT_TRUE(extra.get(value));
+    EXPECT_EQ(id, 1);
+    EXPECT_EQ(value, 2.5f);
+
+    // 恢复默认值后 tag 为 16 字节
+    sender.default_link();
+    sender.Out.clear();
+    extra.reset();
+    extra.add<PropertyId>(1);
+    sender.send(Command::GET_PROPERTY, extra, true);
+    EXPECT_EQ(sender.Out.size(), sizeof(Header) + sizeof(Checksum) + 16 + 2 + sizeof(Checksum));
+}
@@ -47,3 +47,66 @@ TEST_F(HostCS, request)
 
     ASSERT_TRUE(memcmp(client.extra.data(), data, sizeof(data)) == 0);
 }
+
+TEST_F(HostCS, capability)
+{
+    Extra     extra;
+    ErrorCode err;
+    client.send(Command::GET_CAPABILITY, extra);
+
+    ASSERT_TRUE(server.poll());
+    client.recv_response(Command::GET_CAPABILITY, err, client.extra);
+
+    Capability cap;
+    EXPECT_EQ(err, ErrorCode::S_OK);
+    ASSERT_TRUE(client.extra.get(cap));
+    EXPECT_EQ(cap.capacity, extra.capacity());
+    EXPECT_EQ(cap.memory, MEMORY_ACCESS_SIZE_MAX);
+    EXPECT_TRUE(cap.has(Feature::ENCRYPT));
+}
+
+TEST_F(HostCS, cipher)
+{
+    Extra       extra;
+    ErrorCode   err;
+    CipherSuite suite = {CipherMode::CCM, CipherKey::AES128, CipherTag::TAG8};
+
+    // 未加密的请求不能修改加密套件, 防止第三方降级
+    extra.add(LinkOption::CIPHER);
+    extra.add(suite.encode());
+    client.send(Command::SET_LINK, extra);
+    EXPECT_FALSE(server.poll());
+    ASSERT_TRUE(client.recv_response(Command::SET_LINK, err, client.extra));
+    EXPECT_EQ(err, ErrorCode::E_NO_PERMISSION);
+    EXPECT_EQ(server.cipher().encode(), 0);
+
+    // 以当前套件加密协商, 应答发送后双方切换
+    extra.reset();
+    extra.add(LinkOption::CIPHER);
+    extra.add(suite.encode());
+    client.send(Command::SET_LINK, extra, true);
+    ASSERT_TRUE(server.poll());
+    ASSERT_TRUE(client.recv_response(Command::SET_LINK, err, client.extra));
+    ASSERT_EQ(err, ErrorCode::S_OK);
+    client.apply_link(LinkOption::CIPHER, suite.encode());
+
+    // 加密的回声
+    extra.reset();
+    extra.add<uint32_t>(0xCAFEBABE);
+    client.send(Command::ECHO, extra, true);
+    ASSERT_TRUE(server.poll());
+    ASSERT_TRUE(client.recv_response(Command::ECHO, err, client.extra));
+    ASSERT_EQ(err, ErrorCode::S_OK);
+    ASSERT_TRUE(client.extra.decrypt(secret.nonce, secret.key, client.cipher()));
+    uint32_t value;
+    ASSERT_TRUE(client.extra.get(value));
+    EXPECT_EQ(value, 0xCAFEBABE);
+
+    // 恢复默认值
+    extra.reset();
+    client.send(Command::SET_LINK, extra);
+    ASSERT_TRUE(server.poll());
+    ASSERT_TRUE(client.recv_response(Command::SET_LINK, err, client.extra));
+    client.default_link();
+    EXPECT_EQ(server.cipher().encode(), 0);
+}
@@ -0,0 +1,221 @@
+#include "gtest/gtest.h"
+#include <CProperty.hpp>
+#include <future>
+#include <HostCS.hpp>
+#include <HostLink.hpp>
+
+static uint32_t                               Values[3];
+static Property<uint32_t, Access::READ_WRITE> Prop_0(Values[0]);
+static Property<uint32_t, Access::READ_WRITE> Prop_1(Values[1]);
+static Property<uint32_t, Access::READ_WRITE> Prop_2(Values[2]);
+// 静态初始化
+static constexpr PropertyMap<3> Map = {
+    {
+     {"prop.0", &(PropertyBase&)Prop_0},
+     {"prop.1", &(PropertyBase&)Prop_1},
+     {"prop.2", &(PropertyBase&)Prop_2},
+     }
+};
+static PropertyHolder            Holder(Map);
+
+static constinit CPropertyMap<3> CMap = {
+    {
+     {"prop.0", 0},
+     {"prop.1", 1},
+     {"prop.2", 2},
+     }
+};
+static CPropertyHolder CHolder(CMap);
+
+/**
+ * @brief 基于队列的传输层, 没有数据时立即返回
+ *
+ */
+struct QueueTransport : public Transport
+{
+    FixedQueue<2048>  In;
+    FixedQueue<2048>* Out = nullptr;
+
+    virtual bool rx(uint8_t& byte) override
+    {
+        return In.pop(&byte);
+    }
+
+    virtual void tx(const void* buf, size_t size) override
+    {
+        for (size_t i = 0; i < size; i++)
+            Out->push(((const uint8_t*)buf)[i]);
+    }
+};
+
+struct THostLink : public testing::Test
+{
+    static constexpr size_t LINKS = 3;
+
+    Address          address = 0;
+    SecretHolderImpl secrets[LINKS];
+    QueueTransport   transports[LINKS];
+    HostLink         links[LINKS] = {
+        {transports[0], address, Holder, secrets[0]},
+        {transports[1], address, Holder, secrets[1]},
+        {transports[2], address, Holder, secrets[2]},
+    };
+    HostLink*        pointers[LINKS] = {&links[0], &links[1], &links[2]};
+    HostLinks        mux {pointers, LINKS};
+    SecretHolderImpl client_secrets[LINKS];
+    HostClientImpl   clients[LINKS] = {
+        {CHolder, client_secrets[0]},
+        {CHolder, client_secrets[1]},
+        {CHolder, client_secrets[2]},
+    };
+
+    THostLink()
+    {
+        for (size_t i = 0; i < LINKS; i++)
+        {
+            transports[i].Out   = &clients[i].Q_Client;
+            clients[i].Q_Server = &transports[i].In;
+            secrets[i].key.fill(0x10 + i);
+            secrets[i].nonce.fill(0x20 + i);
+            client_secrets[i] = secrets[i];
+        }
+    }
+
+    void echo(size_t link, uint32_t value, bool encrypt = false)
+    {
+        Extra extra;
+        extra.add(value);
+        clients[link].send(Command::ECHO, extra, encrypt);
+    }
+};
+
+TEST_F(THostLink, Concurrent)
+{
+    bool              running = true;
+    std::future<void> server  = std::async(std::launch::async,
+                                           [&]()
+                                           {
+                                               while (running)
+                                                   mux.poll();
+                                           });
+
+    std::future<void> tasks[LINKS];
+    for (size_t i = 0; i < LINKS; i++)
+    {
+        tasks[i] = std::async(std::launch::async,
+                              [this, i]()
+                              {
+                                  CProperty<uint32_t, Access::READ_WRITE> prop(CMap.begin()[i].first);
+                                  for (uint32_t n = 0; n < 200; n++)
+                                  {
+                                      uint32_t value = (i << 16) | n;
+                                      ASSERT_EQ(prop.set(clients[i], value), ErrorCode::S_OK);
+                                      ASSERT_EQ(prop.get(clients[i], value), ErrorCode::S_OK);
+                                      ASSERT_EQ(value, (i << 16) | n);
+                                  }
+                              });
+    }
+    for (auto& task : tasks)
+        task.get();
+    running = false;
+    server.get();
+
+    // 同一个属性值容器
+    for (size_t i = 0; i < LINKS; i++)
+        EXPECT_EQ(Values[i], (i << 16) | 199);
+}
+
+TEST_F(THostLink, Resume)
+{
+    ErrorCode err;
+
+    // 其他地址的帧在解析时丢弃
+    clients[0].address = 5;
+    echo(0, 0x11111111);
+    clients[0].address = 0;
+    echo(0, 0x22222222);
+
+    // 逐字节到达, 半帧时不交给协议引擎
+    size_t bytes = transports[0].In.size();
+    for (size_t i = 1; i < bytes; i++)
+    {
+        ASSERT_FALSE(links[0].pump(1));
+        EXPECT_FALSE(links[0].poll());
+    }
+    ASSERT_TRUE(links[0].pump(1));
+    ASSERT_TRUE(links[0].poll());
+    EXPECT_EQ(links[0].stats().foreign, 1);
+    EXPECT_EQ(links[0].stats().frames, 1);
+
+    ASSERT_TRUE(clients[0].recv_response(Command::ECHO, err, clients[0].extra));
+    uint32_t value;
+    ASSERT_TRUE(clients[0].extra.get(value));
+    EXPECT_EQ(value, 0x22222222);
+}
+
+TEST_F(THostLink, Fair)
+{
+    // 链路 0 持续发送, 链路 1 只有一帧
+    for (uint32_t i = 0; i < 10; i++)
+        echo(0, i);
+    echo(1, 0xABCD);
+
+    // 每轮每个端点最多处理一帧
+    EXPECT_EQ(mux.poll(), 2);
+    EXPECT_FALSE(clients[1].Q_Client.empty());
+    for (size_t round = 1; round < 10; round++)
+        EXPECT_EQ(mux.poll(), 1);
+    EXPECT_EQ(mux.poll(), 0);
+    EXPECT_EQ(links[0].stats().frames, 10);
+}
+
+TEST_F(THostLink, Session)
+{
+    ErrorCode err;
+
+    // 每个端点使用自己的密钥
+    echo(1, 0x5A5A5A5A, true);
+    clients[2].secret.key = secrets[1].key;
+    echo(2, 0x5A5A5A5A, true);
+    mux.poll();
+
+    ASSERT_TRUE(clients[1].recv_response(Command::ECHO, err, clients[1].extra));
+    EXPECT_EQ(err, ErrorCode::S_OK);
+    ASSERT_TRUE(clients[2].recv_response(Command::ECHO, err, clients[2].extra));
+    EXPECT_EQ(err, ErrorCode::E_INVALID_ARG);
+}
+
+TEST_F(THostLink, Oversize)
+{
+    ErrorCode err;
+
+    std::vector<uint8_t> payload(HostLink::STAGE, 0x55);
+    Header               head;
+    head.address    = 0;
+    head.cmd        = Command::ECHO;
+    head.error      = ErrorCode::S_OK;
+    head.size       = payload.size();
+    Checksum chksum = __builtin_bswap16(crc_ccitt_ffff((const uint8_t*)&head, sizeof(head)));
+    // 直接写入 Server 的接收队列
+    for (size_t i = 0; i < sizeof(head); i++)
+        transports[0].In.push(((uint8_t*)&head)[i]);
+    for (size_t i = 0; i < sizeof(chksum); i++)
+        transports[0].In.push(((uint8_t*)&chksum)[i]);
+    // 超长的帧在附加参数到达前就被拒绝
+    EXPECT_EQ(mux.poll(), 1);
+    ASSERT_TRUE(clients[0].recv_response(Command::ECHO, err, clients[0].extra));
+    EXPECT_EQ(err, ErrorCode::E_OUT_OF_BUFFER);
+
+    // 附加参数和校验和到达后被丢弃, 下一帧正常处理
+    for (size_t sent = 0; sent < payload.size() + sizeof(Checksum); sent += 256)
+    {
+        for (size_t i = sent; i < std::min(sent + 256, payload.size() + sizeof(Checksum)); i++)
+            transports[0].In.push(0x55);
+        links[0].pump(SIZE_MAX);
+    }
+    echo(0, 0x12345678);
+    EXPECT_EQ(mux.poll(), 1);
+    ASSERT_TRUE(clients[0].recv_response(Command::ECHO, err, clients[0].extra));
+    EXPECT_EQ(err, ErrorCode::S_OK);
+    EXPECT_EQ(links[0].stats().oversize, 1);
+}
@@ -0,0 +1,59 @@
+#include "gtest/gtest.h"
+#include <Latch.hpp>
+#include <Property.hpp>
+
+static float                                    FloatVal;
+static uint16_t                                 ShortVal;
+static Property<float>                          Prop_1(FloatVal);
+static Property<uint16_t>                       Prop_2(ShortVal);
+static Property<uint16_t, Access::READ_PROTECT> Prop_3(ShortVal);
+
+TEST(Latch, Trigger)
+{
+    Latch<2, 8>    latch;
+    Extra          extra;
+    const uint8_t* data;
+    Size           size;
+
+    ASSERT_EQ(latch.add(&Prop_1), ErrorCode::S_OK);
+    ASSERT_EQ(latch.add(&Prop_2), ErrorCode::S_OK);
+    EXPECT_EQ(latch.add(&Prop_1), ErrorCode::E_OUT_OF_INDEX);
+    EXPECT_EQ(latch.channels(), 2);
+
+    FloatVal = 1.5f;
+    ShortVal = 3;
+    latch.trigger(5);
+    FloatVal = 2.5f;
+
+    // 锁存值不随属性值变化
+    ASSERT_EQ(latch.get_view(extra, false, data, size), ErrorCode::S_OK);
+    ASSERT_EQ(size, 2 + 4 + 2);
+    EXPECT_EQ(*(uint16_t*)data, 5);
+    EXPECT_EQ(*(float*)&data[2], 1.5f);
+    EXPECT_EQ(*(uint16_t*)&data[6], 3);
+    EXPECT_EQ(latch.seq(), 5);
+
+    ASSERT_EQ(latch.get_size(extra, false), ErrorCode::S_OK);
+    Size length;
+    extra.seek(0);
+    ASSERT_TRUE(extra.get(length));
+    EXPECT_EQ(length, 8);
+
+    // 只读
+    EXPECT_EQ(latch.check_write(true), ErrorCode::E_READ_ONLY);
+
+    // 超出影子缓冲区
+    Latch<2, 4> small;
+    ASSERT_EQ(small.add(&Prop_1), ErrorCode::S_OK);
+    EXPECT_EQ(small.add(&Prop_2), ErrorCode::E_OUT_OF_BUFFER);
+
+    // 锁存器不加密读取, 受保护的属性不能锁存
+    Latch<1> secure;
+    EXPECT_EQ(secure.add(&Prop_3), ErrorCode::E_NO_PERMISSION);
+    EXPECT_EQ(secure.channels(), 0);
+
+    latch.clear();
+    latch.trigger(6);
+    ASSERT_EQ(latch.get(extra, false), ErrorCode::S_OK);
+    EXPECT_EQ(extra.size(), 2);
+}
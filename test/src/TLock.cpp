@@ -0,0 +1,270 @@
+#include "gtest/gtest.h"
+#include <CMemory.hpp>
+#include <future>
+#include <HostCS.hpp>
+#include <mutex>
+#include <SeqMemory.hpp>
+
+struct IrqLockImpl : public IrqLock
+{
+    bool     Enabled  = true;
+    uint32_t Disabled = 0;
+
+    virtual uint32_t disable_irq() override
+    {
+        uint32_t state = Enabled;
+        Enabled        = false;
+        Disabled++;
+        return state;
+    }
+
+    virtual void restore_irq(uint32_t state) override
+    {
+        Enabled = state;
+    }
+};
+
+TEST(Lock, IrqLock_Nested)
+{
+    IrqLockImpl lock;
+    {
+        LockGuard outer(lock);
+        {
+            LockGuard inner(lock);
+            EXPECT_FALSE(lock.Enabled);
+        }
+        // 内层解锁不恢复中断
+        EXPECT_FALSE(lock.Enabled);
+    }
+    EXPECT_TRUE(lock.Enabled);
+    EXPECT_EQ(lock.Disabled, 2);
+}
+
+TEST(Lock, SeqLock_Read)
+{
+    SeqLock  seq;
+    uint32_t calls = 0;
+
+    EXPECT_TRUE(seq.read([&] { calls++; }));
+    EXPECT_EQ(calls, 1);
+
+    // 写入期间读取失败
+    calls = 0;
+    seq.lock();
+    EXPECT_FALSE(seq.read([&] { calls++; }));
+    EXPECT_EQ(calls, 0);
+    seq.unlock();
+    EXPECT_TRUE(seq.read([] {}));
+
+    // 复制期间被写入时重试
+    calls = 0;
+    EXPECT_TRUE(seq.read(
+        [&]
+        {
+            if (calls++ == 0)
+            {
+                seq.lock();
+                seq.unlock();
+            }
+        }));
+    EXPECT_EQ(calls, 2);
+}
+
+using ArrayType = std::array<uint8_t, 1000>;
+
+static ArrayType                ArrayVal;
+static SeqMemory<ArrayType>     Prop_1(ArrayVal);
+// 静态初始化
+static constexpr PropertyMap<1> Map = {
+    {
+     {"prop.1", &(PropertyBase&)Prop_1},
+     }
+};
+static PropertyHolder            Holder(Map);
+
+static constinit CPropertyMap<1> CMap = {
+    {
+     {"prop.1", 0},
+     }
+};
+static CPropertyHolder CHolder(CMap);
+
+struct TLock
+    : public HostCSBase
+    , public testing::Test
+{
+    MutexLock<std::mutex> TxLock;
+    bool                  Running = true;
+    std::future<void>     end;
+
+    TLock()
+        : HostCSBase(Holder, CHolder, TxLock)
+    {
+    }
+
+    virtual void SetUp()
+    {
+        end = std::async(std::launch::async,
+                         [this]()
+                         {
+                             while (Running)
+                             {
+                                 server.poll();
+                             }
+                         });
+    }
+
+    virtual void TearDown()
+    {
+        Running        = false;
+        server.Running = false;
+        end.get();
+    }
+};
+
+TEST_F(TLock, Log_Concurrent)
+{
+    constexpr size_t   count = 50;
+    ArrayType          CArrayVal;
+    CMemory<ArrayType> c_prop("prop.1");
+    std::atomic<bool>  logging = true;
+
+    // 日志任务与 poll 同时发送
+    std::future<void> logger = std::async(std::launch::async,
+                                          [&]()
+                                          {
+                                              const char log[] = "\x02log message";
+                                              for (size_t i = 0; i < count; i++)
+                                              {
+                                                  server.log(log, sizeof(log));
+                                                  std::this_thread::yield();
+                                              }
+                                              logging = false;
+                                          });
+
+    // 帧交错时响应会丢失, 读取将无法完成
+    while (logging)
+        ASSERT_EQ(c_prop.get(client, 0, &CArrayVal, 16), ErrorCode::S_OK);
+    logger.get();
+    ASSERT_EQ(c_prop.get(client, 0, &CArrayVal, 16), ErrorCode::S_OK);
+    EXPECT_EQ(client.Logs, count);
+}
+
+TEST_F(TLock, SeqMemory_Consistent)
+{
+    ArrayType          CArrayVal;
+    CMemory<ArrayType> c_prop("prop.1");
+    std::atomic<bool>  writing = true;
+
+    // 控制环路持续写入
+    std::future<void> writer = std::async(std::launch::async,
+                                          [&]()
+                                          {
+                                              uint8_t value = 0;
+                                              while (writing)
+                                              {
+                                                  {
+                                                      LockGuard guard(Prop_1.seq);
+                                                      ArrayVal.fill(value++);
+                                                  }
+                                                  std::this_thread::sleep_for(std::chrono::microseconds(10));
+                                              }
+                                          });
+
+    size_t ok = 0;
+    for (size_t i = 0; i < 200; i++)
+    {
+        ErrorCode err = c_prop.get(client, 0, &CArrayVal, sizeof(CArrayVal));
+        // 写入过于频繁时允许读取超时, 但不允许读到不一致的数据
+        if (err == ErrorCode::E_TIMEOUT) continue;
+        ASSERT_EQ(err, ErrorCode::S_OK);
+        for (auto byte : CArrayVal)
+            ASSERT_EQ(byte, CArrayVal[0]);
+        ok++;
+    }
+    writing = false;
+    writer.get();
+    EXPECT_GT(ok, 0);
+}
+
+/**
+ * @brief 记录持有状态的属性锁
+ *
+ */
+struct HeldLock : public MutexLock<std::mutex>
+{
+    std::atomic<bool> Held = false;
+
+    virtual void lock() override
+    {
+        MutexLock::lock();
+        Held = true;
+    }
+
+    virtual void unlock() override
+    {
+        Held = false;
+        MutexLock::unlock();
+    }
+};
+
+/**
+ * @brief 检查发送期间是否持有属性锁的 Server
+ *
+ */
+struct HeldServer : public HostServerImpl
+{
+    HeldLock& PropLock;
+    size_t    HeldTx = 0;
+
+    HeldServer(const PropertyHolderBase& holder, SecretHolder& secret, HeldLock& prop_lock)
+        : HostServerImpl(holder, secret, no_lock, prop_lock)
+        , PropLock(prop_lock)
+    {
+    }
+
+    virtual void tx(const void* buf, size_t size) override
+    {
+        if (PropLock.Held) HeldTx++;
+        HostServerImpl::tx(buf, size);
+    }
+};
+
+static std::array<uint8_t, 512>         PlainVal;
+static Memory<std::array<uint8_t, 512>> Prop_2(PlainVal);
+static constexpr PropertyMap<1>         PlainMap = {
+    {
+     {"prop.1", &(PropertyBase&)Prop_2},
+     }
+};
+static PropertyHolder PlainHolder(PlainMap);
+
+TEST(Lock, PropLock_NotHeldDuringTx)
+{
+    SecretHolderImpl                  secret;
+    HeldLock                          prop_lock;
+    HeldServer                        server(PlainHolder, secret, prop_lock);
+    HostClientImpl                    client(CHolder, secret);
+    CMemory<std::array<uint8_t, 512>> c_prop("prop.1");
+    uint8_t                           buffer[256];
+
+    server.Q_Client = &client.Q_Client;
+    client.Q_Server = &server.Q_Server;
+    std::future<void> end = std::async(std::launch::async,
+                                       [&]()
+                                       {
+                                           while (server.Running)
+                                               server.poll();
+                                       });
+
+    // 属性锁不是空锁时先复制到缓冲区, 释放后再发送
+    PlainVal.fill(0x5A);
+    EXPECT_EQ(c_prop.get(client, 0, buffer, sizeof(buffer)), ErrorCode::S_OK);
+    EXPECT_EQ(buffer[0], 0x5A);
+    EXPECT_EQ(buffer[sizeof(buffer) - 1], 0x5A);
+    EXPECT_GT(server.TxCalls, 0);
+    EXPECT_EQ(server.HeldTx, 0);
+
+    server.Running = false;
+    end.get();
+}
@@ -0,0 +1,144 @@
+#include "gtest/gtest.h"
+#include <CProperty.hpp>
+#include <future>
+#include <HostCS.hpp>
+#include <mutex>
+
+TEST(LogBuffer, PushPop)
+{
+    LogBuffer<300> buffer;
+    uint8_t        buf[300];
+
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_TRUE(buffer.push(LogLevel::INFO, "abc", 3));
+    EXPECT_TRUE(buffer.push(LogLevel::ERROR, "de", 2));
+    EXPECT_FALSE(buffer.empty());
+
+    // 只取出完整的日志
+    EXPECT_EQ(buffer.pop(buf, 6), 5);
+    EXPECT_EQ(buf[0], (uint8_t)LogLevel::INFO);
+    EXPECT_EQ(buf[1], 3);
+    EXPECT_EQ(memcmp(&buf[2], "abc", 3), 0);
+    EXPECT_EQ(buffer.pop(buf, sizeof(buf)), 4);
+    EXPECT_EQ(buf[0], (uint8_t)LogLevel::ERROR);
+    EXPECT_EQ(buf[1], 2);
+    EXPECT_EQ(memcmp(&buf[2], "de", 2), 0);
+    EXPECT_TRUE(buffer.empty());
+
+    // 超长的日志被截断
+    uint8_t large[400] = {};
+    EXPECT_TRUE(buffer.push(LogLevel::INFO, large, sizeof(large)));
+    EXPECT_EQ(buffer.pop(buf, sizeof(buf)), 2 + LogBufferBase::RECORD_MAX);
+}
+
+TEST(LogBuffer, Filter)
+{
+    LogBuffer<300> buffer;
+
+    buffer.config.level = LogLevel::WARNING;
+    EXPECT_FALSE(buffer.push(LogLevel::INFO, "a", 1));
+    EXPECT_TRUE(buffer.push(LogLevel::WARNING, "b", 1));
+    EXPECT_EQ(buffer.dropped(), 0);
+}
+
+TEST(LogBuffer, Overflow)
+{
+    LogBuffer<300> buffer;
+    uint8_t        buf[300];
+    uint8_t        data[98];
+
+    // 每条日志占用 100 字节
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        memset(data, i, sizeof(data));
+        EXPECT_TRUE(buffer.push(LogLevel::INFO, data, sizeof(data)));
+    }
+
+    // 丢弃新的日志
+    EXPECT_FALSE(buffer.push(LogLevel::INFO, data, 1));
+    EXPECT_EQ(buffer.dropped(), 1);
+
+    // 丢弃最早的日志, 写入位置回绕
+    buffer.config.overflow = LogOverflow::DROP_OLD;
+    memset(data, 3, sizeof(data));
+    EXPECT_TRUE(buffer.push(LogLevel::INFO, data, sizeof(data)));
+    EXPECT_EQ(buffer.dropped(), 2);
+
+    EXPECT_EQ(buffer.pop(buf, sizeof(buf)), 300);
+    EXPECT_EQ(buf[2], 1);
+    EXPECT_EQ(buf[102], 2);
+    EXPECT_EQ(buf[202], 3);
+    EXPECT_EQ(buf[299], 3);
+}
+
+static MutexLock<std::mutex>                   BufferLock;
+static LogBuffer<1024>                         Buffer(BufferLock);
+static Property<LogConfig, Access::READ_WRITE> Prop_1(Buffer.config);
+// 静态初始化
+static constexpr PropertyMap<1>                Map = {
+    {
+     {"log.config", &(PropertyBase&)Prop_1},
+     }
+};
+static PropertyHolder            Holder(Map);
+
+static constinit CPropertyMap<1> CMap = {
+    {
+     {"log.config", 0},
+     }
+};
+static CPropertyHolder CHolder(CMap);
+
+struct TLogBuffer
+    : public HostCSBase
+    , public testing::Test
+{
+    bool              Running = true;
+    std::future<void> end;
+
+    TLogBuffer()
+        : HostCSBase(Holder, CHolder)
+    {
+        server.set_log_buffer(&Buffer);
+    }
+
+    virtual void SetUp()
+    {
+        end = std::async(std::launch::async,
+                         [this]()
+                         {
+                             while (Running)
+                             {
+                                 server.poll();
+                             }
+                         });
+    }
+
+    virtual void TearDown()
+    {
+        Running        = false;
+        server.Running = false;
+        end.get();
+    }
+};
+
+TEST_F(TLogBuffer, Batch)
+{
+    LogConfig            config;
+    CProperty<LogConfig> c_prop("log.config");
+
+    config.level    = LogLevel::WARNING;
+    config.overflow = LogOverflow::DROP_NEW;
+    ASSERT_EQ(c_prop.set(client, config), ErrorCode::S_OK);
+
+    server.log(LogLevel::INFO, "filtered", 8);
+    for (size_t i = 0; i < 10; i++)
+        server.log(LogLevel::ERROR, "error", 5);
+
+    // 日志在下一次 poll 时批量发送, 在接收下一个响应时输出
+    ASSERT_EQ(c_prop.get(client, config), ErrorCode::S_OK);
+    ASSERT_EQ(c_prop.get(client, config), ErrorCode::S_OK);
+    EXPECT_EQ(config.level, LogLevel::WARNING);
+    EXPECT_EQ(client.Logs, 10);
+    EXPECT_TRUE(Buffer.empty());
+}
@@ -0,0 +1,124 @@
+#include "gtest/gtest.h"
+#include <CLogFormats.hpp>
+#include <future>
+#include <HostCS.hpp>
+
+static constexpr LogFormatTable<4> Formats = {
+    "boot",
+    "motor %u: speed=%.2f, pos=%lld",
+    "%s %c %d %lf %x %%",
+    "%f %zu %ld %x %hhu %c",
+};
+static LogFormats<4>            Prop_1(Formats);
+// 静态初始化
+static constexpr PropertyMap<1> Map = {
+    {
+     {"log.formats", &(PropertyBase&)Prop_1},
+     }
+};
+static PropertyHolder            Holder(Map);
+
+static constinit CPropertyMap<1> CMap = {
+    {
+     {"log.formats", 0},
+     }
+};
+static CPropertyHolder CHolder(CMap);
+
+struct TLogFormat
+    : public HostCSBase
+    , public testing::Test
+{
+    bool              Running = true;
+    std::future<void> end;
+
+    TLogFormat()
+        : HostCSBase(Holder, CHolder)
+    {
+    }
+
+    virtual void SetUp()
+    {
+        end = std::async(std::launch::async,
+                         [this]()
+                         {
+                             while (Running)
+                             {
+                                 server.poll();
+                             }
+                         });
+    }
+
+    virtual void TearDown()
+    {
+        Running        = false;
+        server.Running = false;
+        end.get();
+    }
+};
+
+TEST(LogFormat, Pack)
+{
+    static_assert(log_format_id(Formats, "boot") == 0);
+    static_assert(log_format_id(Formats, "%s %c %d %lf %x %%") == 2);
+
+    LogArgs args(1);
+    args.add((uint8_t)3);
+    args.add(1.5f);
+    args.add((int64_t)-1);
+    // Id + 带长度的整数 + double + 带长度的整数, 远小于展开后的文本
+    EXPECT_EQ(args.size(), 2 + (1 + 1) + 8 + (1 + 8));
+
+    // 超出长度的参数及其后的参数被丢弃
+    LogArgs full(0);
+    char    str[300] = {};
+    memset(str, 'a', sizeof(str) - 1);
+    full.add((const char*)str);
+    EXPECT_EQ(full.size(), LogArgs::CAPACITY);
+    full.add(1);
+    EXPECT_EQ(full.size(), LogArgs::CAPACITY);
+    // 缓冲区已满时字符串的长度也不写入
+    full.add("b");
+    EXPECT_EQ(full.size(), LogArgs::CAPACITY);
+}
+
+TEST_F(TLogFormat, Expand)
+{
+    CLogFormats<4, 128> formats("log.formats");
+    ASSERT_EQ(formats.refresh(client), ErrorCode::S_OK);
+    ASSERT_EQ(formats.size(), 4);
+    client.formats = &formats;
+
+    server.log_fmt(LogLevel::INFO, 1, (uint8_t)3, 1.5f, (int64_t)-1);
+    ASSERT_EQ(client.negotiate(), ErrorCode::S_OK);
+    EXPECT_EQ(client.Logs, 1);
+    EXPECT_EQ(client.LastLevel, LogLevel::INFO);
+    EXPECT_EQ(client.LastLog, "motor 3: speed=1.50, pos=-1");
+
+    server.log_fmt(LogLevel::ERROR, 2, "abc", 'x', -2, 0.25, 255u);
+    ASSERT_EQ(client.negotiate(), ErrorCode::S_OK);
+    EXPECT_EQ(client.LastLevel, LogLevel::ERROR);
+    EXPECT_EQ(client.LastLog, "abc x -2 0.250000 ff %");
+
+    // 按 printf 的习惯书写: %f 对应 double, %zu/%ld 对应本机的 size_t/long, %c 对应 int
+    server.log_fmt(LogLevel::INFO, 3, 1.5, sizeof(uint64_t), -3L, -1, (uint8_t)200, 'y');
+    ASSERT_EQ(client.negotiate(), ErrorCode::S_OK);
+    EXPECT_EQ(client.LastLog, "1.500000 8 -3 ffffffff 200 y");
+
+    // 参数不足
+    server.log_fmt(LogLevel::WARNING, 2, "abc");
+    ASSERT_EQ(client.negotiate(), ErrorCode::S_OK);
+    EXPECT_EQ(client.LastLog, "abc <?>");
+
+    // 未知的格式
+    server.log_fmt(LogLevel::WARNING, 7);
+    ASSERT_EQ(client.negotiate(), ErrorCode::S_OK);
+    EXPECT_EQ(client.LastLog, "<unknown log format>");
+
+    // 未设置格式表时原样输出
+    client.formats = nullptr;
+    server.log_fmt(LogLevel::INFO, 0);
+    ASSERT_EQ(client.negotiate(), ErrorCode::S_OK);
+    EXPECT_EQ((uint8_t)client.LastLevel, (uint8_t)LogLevel::INFO | LOG_BINARY);
+    EXPECT_EQ(client.LastLog.size(), sizeof(LogFormatId));
+}
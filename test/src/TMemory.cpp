@@ -5,8 +5,9 @@
 
 TEST(Memory, sizeof)
 {
-    EXPECT_EQ(sizeof(Memory<bool>), 8);
-    EXPECT_EQ(sizeof(Memory<float>), 8);
+    // 虚表指针 + 引用
+    EXPECT_EQ(sizeof(Memory<bool>), 2 * sizeof(void*));
+    EXPECT_EQ(sizeof(Memory<float>), 2 * sizeof(void*));
 }
 
 TEST(MemoryAccess, sizeof)
@@ -96,6 +97,38 @@ TEST_F(TMemory, Get)
     EXPECT_TRUE(memcmp(recv.data(), ArrayVal.data(), access.size) == 0);
 }
 
+TEST_F(TMemory, Get_Direct)
+{
+    // 初始化内存区
+    for (size_t i = 0; i < ArrayVal.size(); i++)
+    {
+        ArrayVal[i] = ~i;
+    }
+
+    Extra     extra;
+    ErrorCode err;
+    extra.add<PropertyId>(0);
+
+    MemoryAccess access;
+    access.offset = 16;
+    access.size   = 512;
+    extra.add(access);
+    client.send(Command::GET_PROPERTY, extra);
+
+    ASSERT_TRUE(server.poll());
+
+    // 直接读取到数组中
+    std::vector<uint8_t> recv;
+    recv.resize(access.size);
+    DirectBuffer direct = {Command::GET_PROPERTY, recv.data(), access.size, false};
+    client.recv_response(Command::GET_PROPERTY, err, client.extra, &direct);
+
+    EXPECT_EQ(err, ErrorCode::S_OK);
+    EXPECT_TRUE(direct.used);
+    EXPECT_EQ(client.extra.size(), 0);
+    EXPECT_TRUE(memcmp(recv.data(), &ArrayVal[access.offset], access.size) == 0);
+}
+
 TEST_F(TMemory, Set_OutOfRange)
 {
     Extra     extra;
@@ -3,8 +3,9 @@
 
 TEST(Property, sizeof)
 {
-    EXPECT_EQ(sizeof(Property<bool>), 8);
-    EXPECT_EQ(sizeof(Property<float>), 8);
+    // 虚表指针 + 引用
+    EXPECT_EQ(sizeof(Property<bool>), 2 * sizeof(void*));
+    EXPECT_EQ(sizeof(Property<float>), 2 * sizeof(void*));
 }
 
 static float                               FloatVal;
@@ -0,0 +1,209 @@
+#include "gtest/gtest.h"
+#include <CProperty.hpp>
+#include <CRecorder.hpp>
+#include <fcntl.h>
+#include <future>
+#include <HostCS.hpp>
+#include <Replay.hpp>
+#include <unistd.h>
+
+static float                     FloatVal;
+static int16_t                   IntVal;
+static PropertySymbols           Symbols;
+static Property<float>           Prop_F(FloatVal);
+static Property<int16_t>         Prop_I(IntVal);
+// 静态初始化
+static constexpr PropertyMap<3>  Map = {
+    {
+     {"symbols", &(PropertyBase&)Symbols},
+     {"prop.f", &(PropertyBase&)Prop_F},
+     {"prop.i", &(PropertyBase&)Prop_I},
+     }
+};
+static PropertyHolder            Holder(Map, Symbols);
+
+static constinit CPropertyMap<3> CMap = {
+    {
+     {"symbols", 0},
+     {"prop.f", 1},
+     {"prop.i", 2},
+     }
+};
+static CPropertyHolder CHolder(CMap);
+
+static std::string temp_path(const char* name)
+{
+    std::string path = testing::TempDir() + name;
+    unlink(path.c_str());
+    return path;
+}
+
+TEST(Recorder, File)
+{
+    std::string     path = temp_path("recorder_file.hsr");
+    CRecorder<2, 4> recorder;
+    Replay          replay;
+    uint64_t        time;
+    const uint8_t*  value;
+
+    EXPECT_EQ(recorder.record("a", 0, &FloatVal, sizeof(FloatVal)), ErrorCode::E_ILLEGAL_STATE);
+    ASSERT_EQ(recorder.open(path.c_str()), ErrorCode::S_OK);
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        float   a = i * 0.5f;
+        uint8_t b = i;
+        ASSERT_EQ(recorder.record("a", i * 10, &a, sizeof(a)), ErrorCode::S_OK);
+        ASSERT_EQ(recorder.record("b", i * 10 + 5, &b, sizeof(b)), ErrorCode::S_OK);
+    }
+    // 长度不同的同名属性
+    EXPECT_EQ(recorder.record("a", 100, &value, sizeof(value)), ErrorCode::E_INVALID_ARG);
+    EXPECT_EQ(recorder.record("c", 100, &FloatVal, sizeof(FloatVal)), ErrorCode::E_OUT_OF_INDEX);
+    ASSERT_EQ(recorder.close(), ErrorCode::S_OK);
+
+    // 追加新会话, 通道号重新分配
+    ASSERT_EQ(recorder.open(path.c_str()), ErrorCode::S_OK);
+    uint8_t b = 0xAA;
+    float   a = 100;
+    ASSERT_EQ(recorder.record("b", 200, &b, sizeof(b)), ErrorCode::S_OK);
+    ASSERT_EQ(recorder.record("a", 200, &a, sizeof(a)), ErrorCode::S_OK);
+    ASSERT_EQ(recorder.close(), ErrorCode::S_OK);
+
+    // 模拟写入中断留下的不完整块
+    int fd = open(path.c_str(), O_WRONLY | O_APPEND);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(write(fd, &RECORD_MAGIC, sizeof(RECORD_MAGIC)), (ssize_t)sizeof(RECORD_MAGIC));
+    close(fd);
+
+    ASSERT_EQ(replay.open(path.c_str()), ErrorCode::S_OK);
+    ASSERT_EQ(replay.channels(), 2);
+    size_t ca = replay.find("a");
+    size_t cb = replay.find("b");
+    ASSERT_LT(ca, 2);
+    ASSERT_LT(cb, 2);
+    EXPECT_EQ(replay.find("c"), 2);
+    EXPECT_EQ(replay.width(ca), sizeof(float));
+    EXPECT_EQ(replay.width(cb), sizeof(uint8_t));
+    ASSERT_EQ(replay.size(ca), 11);
+    ASSERT_EQ(replay.size(cb), 11);
+
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        ASSERT_TRUE(replay.at(ca, i, time, value));
+        EXPECT_EQ(time, i * 10);
+        EXPECT_EQ(*(const float*)value, i * 0.5f);
+        ASSERT_TRUE(replay.at(cb, i, time, value));
+        EXPECT_EQ(time, i * 10 + 5);
+        EXPECT_EQ(*value, i);
+    }
+    ASSERT_TRUE(replay.at(cb, 10, time, value));
+    EXPECT_EQ(*value, 0xAA);
+    EXPECT_FALSE(replay.at(cb, 11, time, value));
+
+    EXPECT_EQ(replay.lower_bound(ca, 0), 0);
+    EXPECT_EQ(replay.lower_bound(ca, 41), 5);
+    EXPECT_EQ(replay.lower_bound(ca, 90), 9);
+    EXPECT_EQ(replay.lower_bound(ca, 150), 10);
+    EXPECT_EQ(replay.lower_bound(ca, 201), 11);
+}
+
+struct TRecorder
+    : public HostCSBase
+    , public testing::Test
+{
+    bool              Running = true;
+    std::future<void> end;
+
+    TRecorder()
+        : HostCSBase(Holder, CHolder)
+    {
+    }
+
+    virtual void SetUp()
+    {
+        end = std::async(std::launch::async,
+                         [this]()
+                         {
+                             while (Running)
+                             {
+                                 server.poll();
+                             }
+                         });
+    }
+
+    virtual void TearDown()
+    {
+        Running        = false;
+        server.Running = false;
+        end.get();
+    }
+};
+
+TEST_F(TRecorder, Replay)
+{
+    std::string        path = temp_path("recorder_replay.hsr");
+    CRecorder<4>       recorder;
+    CProperty<float>   c_prop_f("prop.f");
+    CProperty<int16_t> c_prop_i("prop.i");
+    float              f;
+    int16_t            i;
+
+    ASSERT_EQ(recorder.open(path.c_str()), ErrorCode::S_OK);
+    client.recorder = &recorder;
+    for (int16_t k = 0; k < 300; k++)
+    {
+        FloatVal = k * 0.25f;
+        IntVal   = -k;
+        ASSERT_EQ(c_prop_f.get(client, f), ErrorCode::S_OK);
+        if (k % 3 == 0)
+        {
+            ASSERT_EQ(c_prop_i.get(client, i), ErrorCode::S_OK);
+        }
+    }
+    ASSERT_EQ(recorder.close(), ErrorCode::S_OK);
+    client.recorder = nullptr;
+
+    Replay replay;
+    ASSERT_EQ(replay.open(path.c_str()), ErrorCode::S_OK);
+    ASSERT_EQ(replay.size(replay.find("prop.f")), 300);
+    ASSERT_EQ(replay.size(replay.find("prop.i")), 100);
+
+    // 以回放的属性代替硬件
+    static constinit CPropertyMap<3> cmap = {
+        {
+         {"symbols", 0},
+         {"prop.f", 0},
+         {"prop.i", 0},
+         }
+    };
+    CPropertyHolder   cholder(cmap);
+    ReplayHolder      holder(replay);
+    HostCSBase        cs(holder, cholder);
+    std::future<void> replay_end = std::async(std::launch::async,
+                                              [&cs]()
+                                              {
+                                                  while (cs.server.Running)
+                                                      cs.server.poll();
+                                              });
+
+    ASSERT_EQ(cholder.refresh(cs.client), ErrorCode::S_OK);
+    EXPECT_EQ(cmap.at("prop.f"), 1);
+    for (int16_t k = 0; k < 300; k++)
+    {
+        ASSERT_EQ(c_prop_f.get(cs.client, f), ErrorCode::S_OK);
+        EXPECT_EQ(f, k * 0.25f);
+    }
+    // 读到最后一个采样点后保持不变
+    ASSERT_EQ(c_prop_f.get(cs.client, f), ErrorCode::S_OK);
+    EXPECT_EQ(f, 299 * 0.25f);
+    ASSERT_EQ(c_prop_i.get(cs.client, i), ErrorCode::S_OK);
+    EXPECT_EQ(i, 0);
+
+    holder.rewind();
+    ASSERT_EQ(c_prop_f.get(cs.client, f), ErrorCode::S_OK);
+    EXPECT_EQ(f, 0);
+    // 只读
+    EXPECT_EQ(c_prop_f.set(cs.client, 1), ErrorCode::E_READ_ONLY);
+
+    cs.server.Running = false;
+    replay_end.get();
+}
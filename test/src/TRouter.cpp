@@ -0,0 +1,294 @@
+#include "gtest/gtest.h"
+#include <CProperty.hpp>
+#include <deque>
+#include <functional>
+#include <HostCS.hpp>
+#include <memory>
+
+static constinit CPropertyMap<1> CMap = {
+    {
+     {"value", 0},
+     }
+};
+static CPropertyHolder CHolder(CMap);
+
+/**
+ * @brief 单线程的 Server, 从 In 读取, 向 Out 写入
+ *
+ */
+struct PipeServer : public HostServer
+{
+    Address                               address;
+    uint32_t                              Value = 0;
+    Property<uint32_t, Access::READ_WRITE> P_Value {Value};
+    PropertyMap<1>                        Map = {
+        {
+         {"value", &P_Value},
+         }
+    };
+    PropertyHolder<1>                     Holder {Map};
+    std::deque<uint8_t>                   In;
+    std::deque<uint8_t>*                  Out = nullptr;
+
+    PipeServer(Address addr, SecretHolder& secret)
+        : HostServer(address, Holder, secret)
+        , address(addr)
+    {
+    }
+
+    virtual bool rx(uint8_t& byte) override
+    {
+        if (In.empty()) return false;
+        byte = In.front();
+        In.pop_front();
+        return true;
+    }
+
+    virtual void tx(const void* buf, size_t size) override
+    {
+        Out->insert(Out->end(), (const uint8_t*)buf, (const uint8_t*)buf + size);
+    }
+};
+
+/**
+ * @brief 路由器的下游总线, 接收缓冲区为空时先让设备处理收到的帧
+ *
+ */
+struct PipeBus : public HostBase
+{
+    Address                  address = 0;
+    SecretHolderImpl         Secret;
+    std::vector<PipeServer*> Devices;
+    std::deque<uint8_t>      In;
+
+    PipeBus()
+        : HostBase(address, Secret)
+    {
+    }
+
+    virtual bool rx(uint8_t& byte) override
+    {
+        if (In.empty())
+        {
+            for (PipeServer* device : Devices)
+                while (!device->In.empty())
+                    device->poll();
+        }
+        // 没有数据即为接收超时
+        if (In.empty()) return false;
+        byte = In.front();
+        In.pop_front();
+        return true;
+    }
+
+    virtual void tx(const void* buf, size_t size) override
+    {
+        for (PipeServer* device : Devices)
+            device->In.insert(device->In.end(), (const uint8_t*)buf, (const uint8_t*)buf + size);
+    }
+};
+
+/**
+ * @brief 单线程的 Client, 接收缓冲区为空时先运行 Idle
+ *
+ */
+struct PipeClient : public HostClientImpl
+{
+    std::deque<uint8_t>   In;
+    std::deque<uint8_t>*  Out = nullptr;
+    std::function<void()> Idle;
+
+    using HostClientImpl::HostClientImpl;
+
+    virtual bool rx(uint8_t& byte) override
+    {
+        if (In.empty() && Idle) Idle();
+        if (In.empty()) return false;
+        byte = In.front();
+        In.pop_front();
+        return true;
+    }
+
+    virtual void tx(const void* buf, size_t size) override
+    {
+        Out->insert(Out->end(), (const uint8_t*)buf, (const uint8_t*)buf + size);
+    }
+};
+
+TEST(Route, Map)
+{
+    constexpr Route route = {0x10, 8, 1};
+    static_assert(route.contains(0x10) && route.contains(0x17));
+    static_assert(!route.contains(0x0F) && !route.contains(0x18));
+    EXPECT_EQ(route.downstream(0x11), 2);
+    EXPECT_EQ(route.upstream(2), 0x11);
+
+    // 两级路由由内向外转换
+    constexpr Route outer = {0x40, 16, 0x10};
+    EXPECT_EQ(outer.upstream(route.upstream(2)), 0x41);
+}
+
+struct TRouter : public testing::Test
+{
+    // 上游地址 0x10~0x17 对应下游地址 1~8
+    static constexpr Route ROUTE = {0x10, 8, 1};
+
+    SecretHolderImpl                         secret;
+    SecretHolderImpl                         hop;
+    PipeBus                                  bus;
+    std::array<RouteLink, 1>                 routes = {
+        {{ROUTE, &bus}}
+    };
+    HostRouter<1>                            hub {routes};
+    PipeServer                               router {1, hop};
+    std::vector<std::unique_ptr<PipeServer>> devices;
+    PipeClient                               client {CHolder, secret};
+    CProperty<uint32_t>                      value {"value"};
+
+    virtual void SetUp()
+    {
+        secret.key   = {1, 2, 3};
+        secret.nonce = {4, 5, 6};
+        hop.key      = {7, 8, 9};
+        hop.nonce    = {4, 5, 6};
+        for (Address i = 1; i <= 2; i++)
+        {
+            // 下游设备与 Client 使用相同的密钥
+            devices.push_back(std::make_unique<PipeServer>(i, secret));
+            devices.back()->Out = &bus.In;
+            bus.Devices.push_back(devices.back().get());
+        }
+        router.Out = &client.In;
+        ASSERT_EQ(router.set_router(&hub), ErrorCode::S_OK);
+        client.Out  = &router.In;
+        client.Idle = [this]() { idle(); };
+    }
+
+    void idle()
+    {
+        while (!router.In.empty())
+            router.poll();
+        while (hub.pump(router))
+            ;
+    }
+};
+
+TEST_F(TRouter, Forward)
+{
+    uint32_t result;
+
+    // 按下游地址 2 访问, 应答来自上游地址
+    client.address = ROUTE.upstream(2);
+    ASSERT_EQ(value.set(client, 42), ErrorCode::S_OK);
+    EXPECT_EQ(devices[1]->Value, 42);
+    EXPECT_EQ(devices[0]->Value, 0);
+    ASSERT_EQ(value.get(client, result), ErrorCode::S_OK);
+    EXPECT_EQ(result, 42);
+
+    // 路由器本机的属性
+    client.address = 1;
+    ASSERT_EQ(value.set(client, 7), ErrorCode::S_OK);
+    EXPECT_EQ(router.Value, 7);
+    EXPECT_EQ(devices[0]->Value, 0);
+    EXPECT_TRUE(router.features() & (uint32_t)Feature::ROUTER);
+}
+
+TEST_F(TRouter, Encrypted)
+{
+    CProperty<uint32_t, Access::WRITE_PROTECT> secure("value");
+
+    // 路由器的密钥与设备不同, 加密帧原样转发, 由设备解密
+    client.address = ROUTE.upstream(1);
+    ASSERT_EQ(secure.set(client, 0x12345678), ErrorCode::S_OK);
+    EXPECT_EQ(devices[0]->Value, 0x12345678);
+}
+
+TEST_F(TRouter, Timeout)
+{
+    uint32_t result;
+
+    // 下游没有地址 6 的设备
+    client.address = ROUTE.upstream(6);
+    EXPECT_EQ(value.get(client, result), ErrorCode::E_TIMEOUT);
+    EXPECT_EQ(hub.timeouts(), 1);
+
+    // 链路参数不转发
+    EXPECT_EQ(client.set_link(LinkOption::CHECKSUM, (uint8_t)ChecksumType::CRC32C), ErrorCode::E_NO_IMPLEMENT);
+}
+
+TEST_F(TRouter, Queue)
+{
+    // 每帧占用 6 + 6 字节, 队列只能容纳 2 帧
+    HostRouter<1, 24> small {routes};
+    ASSERT_EQ(router.set_router(&small), ErrorCode::S_OK);
+    client.Idle    = nullptr;
+    client.address = ROUTE.upstream(1);
+
+    Extra& extra = client.extra;
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        extra.reset();
+        extra.add<PropertyId>(0);
+        extra.add(i);
+        client.send(Command::SET_PROPERTY, extra);
+    }
+    while (!router.In.empty())
+        router.poll();
+    EXPECT_EQ(small.rejected(), 1);
+
+    // 第 3 帧立即被拒绝, 其余 2 帧转发后依次应答
+    ErrorCode err;
+    ASSERT_TRUE(client.recv_response(Command::SET_PROPERTY, err, extra));
+    EXPECT_EQ(err, ErrorCode::E_OUT_OF_BUFFER);
+    while (small.pump(router))
+        ;
+    for (size_t i = 0; i < 2; i++)
+    {
+        ASSERT_TRUE(client.recv_response(Command::SET_PROPERTY, err, extra));
+        EXPECT_EQ(err, ErrorCode::S_OK);
+    }
+    EXPECT_EQ(devices[0]->Value, 1);
+}
+
+TEST_F(TRouter, Broadcast)
+{
+    CProperty<uint32_t, Access::READ_WRITE> setpoint("value");
+
+    // 广播帧在路由器执行并转发到下游
+    ASSERT_EQ(setpoint.broadcast(client, ADDRESS_BROADCAST, 99), ErrorCode::S_OK);
+    idle();
+    EXPECT_EQ(router.Value, 99);
+    for (auto& device : devices)
+    {
+        while (!device->In.empty())
+            device->poll();
+        EXPECT_EQ(device->Value, 99);
+    }
+    EXPECT_TRUE(bus.In.empty());
+    EXPECT_TRUE(client.In.empty());
+}
+
+TEST_F(TRouter, Verify)
+{
+    // 覆盖广播地址, 下游范围包含广播地址, 覆盖本机地址, 空路由
+    const Route invalid[] = {
+        {0xF8, 8, 1},
+        {0x10, 8, 0xF8},
+        {0x00, 8, 1},
+        {0x10, 0, 1},
+    };
+    for (const Route& route : invalid)
+    {
+        std::array<RouteLink, 1> table = {
+            {{route, &bus}}
+        };
+        HostRouter<1> other {table};
+        EXPECT_EQ(router.set_router(&other), ErrorCode::E_INVALID_ARG);
+    }
+
+    // 保持原路由器
+    uint32_t result;
+    client.address = ROUTE.upstream(1);
+    EXPECT_EQ(value.get(client, result), ErrorCode::S_OK);
+    EXPECT_EQ(router.set_router(nullptr), ErrorCode::S_OK);
+}
@@ -0,0 +1,120 @@
+#include "gtest/gtest.h"
+#include <CSchema.hpp>
+#include <future>
+#include <HostCS.hpp>
+#include <Schema.hpp>
+
+// 固件和上位机共同包含的描述
+static constexpr Schema MySchema(Field<float, Access::READ_WRITE>("speed"), Field<uint32_t>("status"),
+                                 Field<uint16_t, Access::READ_WRITE>("mode"));
+static_assert(MySchema.id("speed") == 2);
+static_assert(MySchema.id("mode") == 4);
+static_assert(MySchema.name(1) == "status");
+
+// 上位机使用的旧描述, 顺序与固件不同
+static constexpr Schema OldSchema(Field<uint16_t, Access::READ_WRITE>("mode"),
+                                  Field<float, Access::READ_WRITE>("speed"));
+static_assert(OldSchema.hash() != MySchema.hash());
+
+struct TSchema
+    : public HostCSBase
+    , public testing::Test
+{
+    static inline float                                  Speed;
+    static inline uint32_t                               Status;
+    static inline uint16_t                               Mode;
+    static inline Property<float, Access::READ_WRITE>    P_Speed {Speed};
+    static inline Property<uint32_t, Access::READ>       P_Status {Status};
+    static inline Property<uint16_t, Access::READ_WRITE> P_Mode {Mode};
+    static inline SchemaServer<MySchema>                 Server {P_Speed, P_Status, P_Mode};
+    static inline CSchema<MySchema>                      CHolder;
+
+    bool              Running = true;
+    std::future<void> end;
+
+    TSchema(CPropertyHolderBase& cholder = CHolder)
+        : HostCSBase(Server.holder, cholder)
+    {
+    }
+
+    virtual void SetUp()
+    {
+        end = std::async(std::launch::async,
+                         [this]()
+                         {
+                             while (Running)
+                             {
+                                 server.poll();
+                             }
+                         });
+    }
+
+    virtual void TearDown()
+    {
+        Running        = false;
+        server.Running = false;
+        end.get();
+    }
+};
+
+TEST_F(TSchema, Field)
+{
+    auto     speed  = CHolder.field<MySchema.index("speed")>();
+    auto     status = CHolder.field<MySchema.index("status")>();
+    auto     mode   = CHolder.field<MySchema.index("mode")>();
+    float    f;
+    uint32_t u;
+    uint16_t m;
+
+    // 描述一致, 只读取散列值
+    ASSERT_EQ(CHolder.refresh(client), ErrorCode::S_OK);
+    EXPECT_TRUE(CHolder.matched());
+
+    ASSERT_EQ(speed.set(client, 1.5f), ErrorCode::S_OK);
+    EXPECT_EQ(Speed, 1.5f);
+    ASSERT_EQ(speed.get(client, f), ErrorCode::S_OK);
+    EXPECT_EQ(f, 1.5f);
+
+    Status = 0x1234;
+    ASSERT_EQ(status.get(client, u), ErrorCode::S_OK);
+    EXPECT_EQ(u, 0x1234);
+    EXPECT_EQ(status.set(client, 1), ErrorCode::E_READ_ONLY);
+
+    ASSERT_EQ(mode.set(client, 7), ErrorCode::S_OK);
+    ASSERT_EQ(mode.get(client, m), ErrorCode::S_OK);
+    EXPECT_EQ(m, 7);
+
+    // 按名称访问仍然可用
+    CProperty<uint16_t, Access::READ_WRITE> c_mode("mode");
+    ASSERT_EQ(c_mode.get(client, m), ErrorCode::S_OK);
+    EXPECT_EQ(m, 7);
+}
+
+struct TSchemaMismatch : public TSchema
+{
+    static inline CSchema<OldSchema> COld;
+
+    TSchemaMismatch()
+        : TSchema(COld)
+    {
+    }
+};
+
+TEST_F(TSchemaMismatch, Refresh)
+{
+    auto     speed = COld.field<OldSchema.index("speed")>();
+    auto     mode  = COld.field<OldSchema.index("mode")>();
+    float    f;
+    uint16_t m;
+
+    // 描述不一致, 通过 symbols 重新映射
+    ASSERT_EQ(COld.refresh(client), ErrorCode::S_OK);
+    EXPECT_FALSE(COld.matched());
+
+    Speed = 2.5f;
+    Mode  = 3;
+    ASSERT_EQ(speed.get(client, f), ErrorCode::S_OK);
+    EXPECT_EQ(f, 2.5f);
+    ASSERT_EQ(mode.get(client, m), ErrorCode::S_OK);
+    EXPECT_EQ(m, 3);
+}
@@ -0,0 +1,146 @@
+#include "gtest/gtest.h"
+#include <CScope.hpp>
+#include <future>
+#include <HostCS.hpp>
+
+static float                                    FloatVal;
+static int32_t                                  IntVal;
+static uint32_t                                 SecretVal;
+static Property<float>                          Prop_1(FloatVal);
+static Property<int32_t>                        Prop_2(IntVal);
+static Property<uint32_t, Access::READ_PROTECT> Prop_3(SecretVal);
+// 静态初始化
+static constexpr PropertyMap<3>                 Map = {
+    {
+     {"prop.1", &(PropertyBase&)Prop_1},
+     {"prop.2", &(PropertyBase&)Prop_2},
+     {"prop.3", &(PropertyBase&)Prop_3},
+     }
+};
+static PropertyHolder            Holder(Map);
+
+static constinit CPropertyMap<3> CMap = {
+    {
+     {"prop.1", 0},
+     {"prop.2", 1},
+     {"prop.3", 2},
+     }
+};
+static CPropertyHolder CHolder(CMap);
+
+TEST(Scope, Tick)
+{
+    Scope<2, 16>   scope;
+    const uint8_t* data;
+    Size           size;
+
+    ASSERT_EQ(scope.add(&Prop_1), ErrorCode::S_OK);
+    ASSERT_EQ(scope.add(&Prop_2), ErrorCode::S_OK);
+    EXPECT_EQ(scope.add(&Prop_3), ErrorCode::E_OUT_OF_INDEX);
+    scope.start(2);
+
+    // 每块 2 个采样点, 每 2 次 tick 采样一次
+    for (int32_t i = 0; i < 4; i++)
+    {
+        FloatVal = i;
+        IntVal   = -i;
+        scope.tick();
+    }
+    ASSERT_TRUE(scope.acquire(data, size));
+    ASSERT_EQ(size, 2 + 16);
+    EXPECT_EQ(*(uint16_t*)data, 0);
+    EXPECT_EQ(*(float*)&data[2], 1);
+    EXPECT_EQ(*(int32_t*)&data[6], -1);
+    EXPECT_EQ(*(float*)&data[10], 3);
+    EXPECT_EQ(*(int32_t*)&data[14], -3);
+
+    // 未发送时另一块写满后丢弃新的采样点
+    for (size_t i = 0; i < 6; i++)
+        scope.tick();
+    EXPECT_EQ(scope.overrun(), 1);
+    scope.release();
+    ASSERT_TRUE(scope.acquire(data, size));
+    EXPECT_EQ(*(uint16_t*)data, 1);
+    scope.release();
+    EXPECT_FALSE(scope.acquire(data, size));
+
+    scope.stop();
+    scope.tick();
+    EXPECT_FALSE(scope.acquire(data, size));
+}
+
+struct TScope
+    : public HostCSBase
+    , public testing::Test
+{
+    Scope<2, 64>      SScope;
+    CScope<2, 32>     Receiver;
+    bool              Running = true;
+    std::future<void> end;
+
+    TScope()
+        : HostCSBase(Holder, CHolder)
+    {
+        server.set_scope(&SScope);
+        client.scope = &Receiver;
+    }
+
+    virtual void SetUp()
+    {
+        end = std::async(std::launch::async,
+                         [this]()
+                         {
+                             while (Running)
+                             {
+                                 server.poll();
+                             }
+                         });
+    }
+
+    virtual void TearDown()
+    {
+        Running        = false;
+        server.Running = false;
+        end.get();
+    }
+};
+
+TEST_F(TScope, Stream)
+{
+    ASSERT_EQ(client.negotiate(), ErrorCode::S_OK);
+    EXPECT_TRUE(client.capability.has(Feature::SCOPE));
+
+    // 受保护的属性不能采样
+    EXPECT_EQ(Receiver.start(client, {"prop.1", "prop.3"}, 1), ErrorCode::E_NO_PERMISSION);
+    ASSERT_EQ(Receiver.start(client, {"prop.1", "prop.2"}, 1), ErrorCode::S_OK);
+    ASSERT_EQ(Receiver.channels(), 2);
+    EXPECT_EQ(Receiver.width(0), sizeof(float));
+
+    // 每块 8 个采样点, 共 5 块
+    for (int32_t i = 0; i < 40; i++)
+    {
+        FloatVal = i * 0.5f;
+        IntVal   = i;
+        SScope.tick();
+        server.flush_scope();
+    }
+    ASSERT_EQ(client.negotiate(), ErrorCode::S_OK);
+
+    // 超出接收器容量的采样点被丢弃
+    ASSERT_EQ(Receiver.size(), 32);
+    EXPECT_EQ(Receiver.lost(), 0);
+    const float*   c1 = Receiver.column<float>(0);
+    const int32_t* c2 = Receiver.column<int32_t>(1);
+    ASSERT_NE(c1, nullptr);
+    ASSERT_NE(c2, nullptr);
+    EXPECT_EQ(Receiver.column<double>(0), nullptr);
+    for (int32_t i = 0; i < 32; i++)
+    {
+        EXPECT_EQ(c1[i], i * 0.5f);
+        EXPECT_EQ(c2[i], i);
+    }
+
+    ASSERT_EQ(Receiver.stop(client), ErrorCode::S_OK);
+    SScope.tick();
+    EXPECT_FALSE(server.flush_scope());
+}
@@ -0,0 +1,42 @@
+#include "gtest/gtest.h"
+#include <Simulator.hpp>
+
+/**
+ * @brief 设备数可通过环境变量 HOST_SIM_DEVICES 调整, 如 1000 个设备的压力测试
+ *
+ */
+static SimConfig sim_config()
+{
+    SimConfig config;
+    if (const char* devices = getenv("HOST_SIM_DEVICES")) config.Devices = std::max(1, atoi(devices));
+    return config;
+}
+
+TEST(Simulator, Clean)
+{
+    SimConfig     config = sim_config();
+    Simulator<16> sim(config);
+    ASSERT_EQ(sim.size(), config.Devices);
+
+    SimReport report = sim.run();
+    report.print(stdout);
+    EXPECT_EQ(report.Requests, config.Devices * config.Requests);
+    EXPECT_EQ(report.Ok, report.Requests);
+}
+
+TEST(Simulator, Impaired)
+{
+    SimConfig config        = sim_config();
+    config.Impair.LatencyUs = 200;
+    config.Impair.Ber       = 1e-4;
+    config.Impair.Loss      = 1e-4;
+    Simulator<16> sim(config);
+
+    SimReport report = sim.run();
+    report.print(stdout);
+    EXPECT_EQ(report.Ok + report.Timeouts + report.Errors + report.Mismatches, report.Requests);
+    EXPECT_GT(report.Timeouts, 0);
+    EXPECT_GT(report.Ok, report.Requests * 9 / 10);
+    // 应答需要等待链路延迟
+    EXPECT_GE(report.percentile(50), config.Impair.LatencyUs);
+}
@@ -20,7 +20,7 @@ static constexpr PropertyMap<5>                    map = {
 };
 static PropertyHolder            holder(map);
 
-static constinit CPropertyMap<1> cmap = {
+static constinit CPropertyMap<5> cmap = {
     {
      {"prop1", 0},
      {"prop2", 1},